@@ -28,6 +28,18 @@ function M:Run(N)
 	end
 	StopTimer()
 
+	StartTimer("read float on bound self")
+	for i=1, N do
+		local Dilation = self.CustomTimeDilation
+	end
+	StopTimer()
+
+	StartTimer("write float on bound self")
+	for i=1, N do
+		self.CustomTimeDilation = 1.0
+	end
+	StopTimer()
+
 	StartTimer("read FString")
 	for i=1, N do
 		local MeshName = Proxy.MeshName
@@ -53,6 +65,24 @@ function M:Run(N)
 	end
 	StopTimer()
 
+	-- 开启了bMathStructsAsTables时，FVector以Lua表的形式传递
+	local bMathStructsAsTables = type(Proxy.COM) == "table"
+	if bMathStructsAsTables then
+		local COMTable = {X = 1.0, Y = 1.0, Z = 1.0}
+		StartTimer("write FVector as table")
+		for i=1, N do
+			Proxy.COM = COMTable
+		end
+		StopTimer()
+
+		local COMPacked = {1.0, 1.0, 1.0}
+		StartTimer("write FVector as packed numbers")
+		for i=1, N do
+			Proxy.COM = COMPacked
+		end
+		StopTimer()
+	end
+
 	StartTimer("read TArray<FVector>")
 	for i=1, N do
 		local Positions = Proxy.Positions
@@ -66,6 +96,13 @@ function M:Run(N)
 	end
 	StopTimer()
 
+	Proxy.Target = Proxy
+	StartTimer("read UObject*")
+	for i=1, N do
+		local Target = Proxy.Target
+	end
+	StopTimer()
+
 	StartTimer("void NOP()")
 	for i=1, N do
 		Proxy:NOP()
@@ -116,6 +153,16 @@ function M:Run(N)
 	end
 	StopTimer()
 
+	if bMathStructsAsTables then
+		local OriginTable = {X = 1.0, Y = 1.0, Z = 1.0}
+		local DirectionTable = {X = 1.0, Y = 0.0, Z = 0.0}
+		StartTimer("bool Raycast(const FVector&, const FVector&) const with tables")
+		for i=1, N do
+			local bHit = Proxy:Raycast(OriginTable, DirectionTable)
+		end
+		StopTimer()
+	end
+
 	local Indices = UE.TArray(0)
 	StartTimer("void GetIndices(TArray<int32>&) const")
 	for i=1, N do
@@ -178,6 +225,140 @@ function M:Run(N)
 		local HitResult = FHitResult()
 	end
 	StopTimer()
+
+	local Velocity = UE.FVector(1.0, 2.0, 3.0)
+	local Position = UE.FVector(0.0, 0.0, 0.0)
+	StartTimer("FVector Position = Position + Velocity * DeltaTime")
+	for i=1, N do
+		Position = Position + Velocity * 0.016
+	end
+	StopTimer()
+
+	StartTimer("FVector Position:MulAdd(Velocity, DeltaTime)")
+	for i=1, N do
+		Position:MulAdd(Velocity, 0.016)
+	end
+	StopTimer()
+
+	StartTimer("FVector Position:Lerp(Origin, Velocity, Alpha)")
+	for i=1, N do
+		Position:Lerp(Origin, Velocity, 0.5)
+	end
+	StopTimer()
+
+	local Map = UE.TMap(0, 0)
+	local Set = UE.TSet(0)
+	for i=1, 1024 do
+		Map:Add(i, i)
+		Set:Add(i)
+	end
+	local Rounds = N // 1024
+
+	StartTimer("TArray<int32> Get with 1024 items")
+	for i=1, Rounds do
+		for j=1, Indices:Length() do
+			local v = Indices:Get(j)
+		end
+	end
+	StopTimer()
+
+	StartTimer("TArray<int32> pairs with 1024 items")
+	for i=1, Rounds do
+		for j, v in pairs(Indices) do
+		end
+	end
+	StopTimer()
+
+	local Visitor = function(k, v) end
+	StartTimer("TArray<int32> ForEach with 1024 items")
+	for i=1, Rounds do
+		Indices:ForEach(Visitor)
+	end
+	StopTimer()
+
+	StartTimer("TMap<int32, int32> pairs with 1024 items")
+	for i=1, Rounds do
+		for k, v in pairs(Map) do
+		end
+	end
+	StopTimer()
+
+	StartTimer("TMap<int32, int32> ForEach with 1024 items")
+	for i=1, Rounds do
+		Map:ForEach(Visitor)
+	end
+	StopTimer()
+
+	StartTimer("TSet<int32> pairs with 1024 items")
+	for i=1, Rounds do
+		for _, v in pairs(Set) do
+		end
+	end
+	StopTimer()
+
+	StartTimer("TSet<int32> ForEach with 1024 items")
+	for i=1, Rounds do
+		Set:ForEach(Visitor)
+	end
+	StopTimer()
+
+	local IndexTable = Indices:ToTable()
+	StartTimer("TArray<int32> ToTable with 1024 items")
+	for i=1, Rounds do
+		IndexTable = Indices:ToTable()
+	end
+	StopTimer()
+
+	StartTimer("TArray<int32> FromTable with 1024 items")
+	for i=1, Rounds do
+		Indices:FromTable(IndexTable)
+	end
+	StopTimer()
+
+	local PositionTable = Positions:ToTable()
+	StartTimer("TArray<FVector> ToTable with 1024 items")
+	for i=1, Rounds do
+		PositionTable = Positions:ToTable()
+	end
+	StopTimer()
+
+	StartTimer("TArray<FVector> FromTable with 1024 items")
+	for i=1, Rounds do
+		Positions:FromTable(PositionTable)
+	end
+	StopTimer()
+
+	StartTimer("TArray<int32> sum by Get with 1024 items")
+	for i=1, Rounds do
+		local Sum = 0
+		for j=1, Indices:Length() do
+			Sum = Sum + Indices:Get(j)
+		end
+	end
+	StopTimer()
+
+	local IndexView = Indices:View()
+	StartTimer("TArray<int32> View:Sum with 1024 items")
+	for i=1, Rounds do
+		local Sum = IndexView:Sum()
+	end
+	StopTimer()
+
+	local PositionView = Positions:View()
+	StartTimer("TArray<FVector> View:Scale with 1024 items")
+	for i=1, Rounds do
+		PositionView:Scale(1.0)
+	end
+	StopTimer()
+
+	local World = self:GetWorld()
+	local ModuleName = "Tests.Benchmark.UnLuaBenchmarkProxy"
+	World:SpawnActor(SpawnClass, Transform, AlwaysSpawn, nil, nil, ModuleName):K2_DestroyActor()
+	StartTimer("spawn bound actor, 1 per 1024 iterations")
+	for i=1, Rounds do
+		World:SpawnActor(SpawnClass, Transform, AlwaysSpawn, nil, nil, ModuleName):K2_DestroyActor()
+	end
+	StopTimer()
 end
 
 return M
@@ -0,0 +1,7 @@
+local M = UnLua.Class()
+
+function M:Capture()
+    G_InnerArray = self.InnerArray
+end
+
+return M
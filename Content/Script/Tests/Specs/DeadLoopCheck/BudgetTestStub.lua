@@ -0,0 +1,11 @@
+local M = UnLua.Class()
+
+function M:Loop(Count)
+    local Result = 0
+    for _ = 1, Count do
+        Result = Result + 1
+    end
+    return Result
+end
+
+return M
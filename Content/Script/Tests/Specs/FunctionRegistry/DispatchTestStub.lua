@@ -0,0 +1,8 @@
+local M = UnLua.Class()
+
+function M:GetCallCount()
+    self.CallCount = (self.CallCount or 0) + 1
+    return self.CallCount
+end
+
+return M
@@ -0,0 +1,7 @@
+local M = UnLua.Class()
+
+function M:Initialize()
+    G_InitializeCount = (G_InitializeCount or 0) + 1
+end
+
+return M
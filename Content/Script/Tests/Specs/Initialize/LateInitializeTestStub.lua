@@ -0,0 +1,3 @@
+local M = UnLua.Class()
+
+return M
@@ -39,10 +39,11 @@ public class Lua : ModuleRules
         m_LibName = GetLibraryName();
         m_BuildSystem = GetBuildSystem();
         m_CompileAsCpp = ShouldCompileAsCpp();
-        m_LibDirName = string.Format("lib-{0}", m_CompileAsCpp ? "cpp" : "c");
+        m_LibDirName = string.Format("lib-{0}-r{1}", m_CompileAsCpp ? "cpp" : "c", LibRevision);
         m_LuaDirName = string.Format("lua-{0}", m_LuaVersion);
 
         PublicIncludePaths.Add(Path.Combine(ModuleDirectory, m_LuaDirName, "src"));
+        PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "lpak"));
 
         var buildMethodName = "BuildFor" + Target.Platform;
 
@@ -436,6 +437,9 @@ public class Lua : ModuleRules
         RuntimeDependencies.Add(dstPath, fullPath);
     }
 
+    // bump it whenever the sources compiled into the library change (e.g. lpak), so stale prebuilt libraries are rebuilt
+    private const int LibRevision = 1;
+
     private readonly string m_LuaVersion;
     private readonly string m_Config;
     private readonly string m_LibName;
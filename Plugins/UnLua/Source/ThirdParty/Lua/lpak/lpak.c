@@ -0,0 +1,236 @@
+/*
+** Tencent is pleased to support the open source community by making UnLua available.
+**
+** Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+**
+** Licensed under the MIT License (the "License");
+** you may not use this file except in compliance with the License. You may obtain a copy of the License at
+**
+** http://opensource.org/licenses/MIT
+**
+** Unless required by applicable law or agreed to in writing,
+** software distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and limitations under the License.
+*/
+
+#define lpak_c
+#define LUA_LIB
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lua.h"
+#include "lauxlib.h"
+
+#include "lpak.h"
+
+#define HEADER_SIZE     16
+#define ENTRY_SIZE      16
+#define CHUNK_ALIGN     8
+
+
+static unsigned int getu32 (const unsigned char *p) {
+  return (unsigned int)p[0] | ((unsigned int)p[1] << 8) |
+         ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+
+static void setu32 (unsigned char *p, unsigned int v) {
+  p[0] = (unsigned char)(v & 0xff);
+  p[1] = (unsigned char)((v >> 8) & 0xff);
+  p[2] = (unsigned char)((v >> 16) & 0xff);
+  p[3] = (unsigned char)((v >> 24) & 0xff);
+}
+
+
+static int checkrange (size_t size, unsigned int offset, unsigned int len) {
+  return offset <= size && len <= size - offset;
+}
+
+
+LUALIB_API int lpak_open (lpak_Archive *A, const void *data, size_t size) {
+  const unsigned char *p = (const unsigned char *)data;
+  unsigned int count, i;
+  if (p == NULL || size < HEADER_SIZE || memcmp(p, LPAK_MAGIC, 4) != 0 ||
+      getu32(p + 4) != LPAK_VERSION)
+    return 0;
+  count = getu32(p + 8);
+  if (count > (size - HEADER_SIZE) / ENTRY_SIZE)
+    return 0;
+  for (i = 0; i < count; i++) {
+    const unsigned char *e = p + HEADER_SIZE + (size_t)i * ENTRY_SIZE;
+    if (!checkrange(size, getu32(e), getu32(e + 4)) ||
+        !checkrange(size, getu32(e + 8), getu32(e + 12)))
+      return 0;
+  }
+  A->data = p;
+  A->size = size;
+  A->count = count;
+  return 1;
+}
+
+
+static int comparename (const unsigned char *data, const unsigned char *e,
+                        const char *name, size_t namelen) {
+  size_t len = getu32(e + 4);
+  int r = memcmp(name, data + getu32(e), len < namelen ? len : namelen);
+  if (r != 0) return r;
+  return (namelen < len) ? -1 : (namelen > len);
+}
+
+
+LUALIB_API int lpak_find (const lpak_Archive *A, const char *name, size_t namelen,
+                          const char **chunk, size_t *chunksize) {
+  unsigned int lo = 0, hi = A->count;
+  while (lo < hi) {  /* binary search in sorted entries */
+    unsigned int mid = lo + (hi - lo) / 2;
+    const unsigned char *e = A->data + HEADER_SIZE + (size_t)mid * ENTRY_SIZE;
+    int r = comparename(A->data, e, name, namelen);
+    if (r == 0) {
+      *chunk = (const char *)(A->data + getu32(e + 8));
+      *chunksize = getu32(e + 12);
+      return 1;
+    }
+    if (r < 0) hi = mid;
+    else lo = mid + 1;
+  }
+  return 0;
+}
+
+
+typedef struct LoadState {
+  const char *chunk;
+  size_t size;
+} LoadState;
+
+
+static const char *reader (lua_State *L, void *ud, size_t *size) {
+  LoadState *ls = (LoadState *)ud;
+  (void)L;
+  *size = ls->size;
+  ls->size = 0;  /* the whole chunk is returned at once */
+  return (*size > 0) ? ls->chunk : NULL;
+}
+
+
+LUALIB_API int lpak_load (lua_State *L, const lpak_Archive *A, const char *name, const char *chunkname) {
+  LoadState ls;
+  if (!lpak_find(A, name, strlen(name), &ls.chunk, &ls.size))
+    return LPAK_NOTFOUND;
+  return lua_load(L, reader, &ls, chunkname ? chunkname : name, "b");
+}
+
+
+typedef struct DumpEntry {
+  const char *name;
+  size_t namelen;
+  size_t chunksize;
+  int chunkindex;  /* index of the dumped chunk in the temporary table */
+} DumpEntry;
+
+
+static int compareentry (const void *a, const void *b) {
+  const DumpEntry *ea = (const DumpEntry *)a;
+  const DumpEntry *eb = (const DumpEntry *)b;
+  size_t len = ea->namelen < eb->namelen ? ea->namelen : eb->namelen;
+  int r = memcmp(ea->name, eb->name, len);
+  if (r != 0) return r;
+  return (ea->namelen < eb->namelen) ? -1 : (ea->namelen > eb->namelen);
+}
+
+
+typedef struct DumpState {
+  int init;
+  luaL_Buffer B;
+} DumpState;
+
+
+static int dumpwriter (lua_State *L, const void *b, size_t size, void *ud) {
+  DumpState *state = (DumpState *)ud;
+  if (!state->init) {
+    state->init = 1;
+    luaL_buffinit(L, &state->B);
+  }
+  luaL_addlstring(&state->B, (const char *)b, size);
+  return 0;
+}
+
+
+static size_t alignup (size_t n) {
+  return (n + CHUNK_ALIGN - 1) & ~(size_t)(CHUNK_ALIGN - 1);
+}
+
+
+LUALIB_API int lpak_dump (lua_State *L, int idx, lua_Writer writer, void *ud, int strip) {
+  static const unsigned char zeros[CHUNK_ALIGN] = {0};
+  DumpEntry *entries;
+  unsigned char header[HEADER_SIZE];
+  size_t count = 0, n = 0, i, offset;
+  int chunks, status = 0;
+  idx = lua_absindex(L, idx);
+  luaL_checktype(L, idx, LUA_TTABLE);
+  lua_pushnil(L);
+  while (lua_next(L, idx) != 0) {
+    if (lua_type(L, -2) != LUA_TSTRING || lua_type(L, -1) != LUA_TFUNCTION)
+      return luaL_error(L, "invalid archive entry, module name to function expected");
+    count++;
+    lua_pop(L, 1);
+  }
+  entries = (DumpEntry *)lua_newuserdatauv(L, count * sizeof(DumpEntry) + 1, 0);
+  lua_createtable(L, (int)count, 0);
+  chunks = lua_gettop(L);
+  lua_pushnil(L);
+  while (lua_next(L, idx) != 0) {  /* dump all functions */
+    DumpState state;
+    DumpEntry *e = &entries[n++];
+    e->name = lua_tolstring(L, -2, &e->namelen);  /* keys are anchored by the source table */
+    state.init = 0;
+    if (lua_dump(L, dumpwriter, &state, strip) != 0 || !state.init)
+      return luaL_error(L, "unable to dump module '%s'", e->name);
+    luaL_pushresult(&state.B);
+    e->chunksize = lua_rawlen(L, -1);
+    e->chunkindex = (int)n;
+    lua_rawseti(L, chunks, n);
+    lua_pop(L, 1);
+  }
+  qsort(entries, count, sizeof(DumpEntry), compareentry);
+  memcpy(header, LPAK_MAGIC, 4);
+  setu32(header + 4, LPAK_VERSION);
+  setu32(header + 8, (unsigned int)count);
+  setu32(header + 12, 0);
+  status = writer(L, header, HEADER_SIZE, ud);
+  offset = HEADER_SIZE + count * ENTRY_SIZE;
+  for (i = 0; i < count; i++)
+    offset += entries[i].namelen;
+  offset = alignup(offset);
+  {  /* index */
+    size_t nameoffset = HEADER_SIZE + count * ENTRY_SIZE;
+    for (i = 0; i < count && status == 0; i++) {
+      unsigned char e[ENTRY_SIZE];
+      if (offset + entries[i].chunksize > 0xffffffffu)
+        return luaL_error(L, "archive too large");
+      setu32(e, (unsigned int)nameoffset);
+      setu32(e + 4, (unsigned int)entries[i].namelen);
+      setu32(e + 8, (unsigned int)offset);
+      setu32(e + 12, (unsigned int)entries[i].chunksize);
+      status = writer(L, e, ENTRY_SIZE, ud);
+      nameoffset += entries[i].namelen;
+      offset = alignup(offset + entries[i].chunksize);
+    }
+    for (i = 0; i < count && status == 0; i++)
+      status = writer(L, entries[i].name, entries[i].namelen, ud);
+    if (status == 0 && alignup(nameoffset) > nameoffset)
+      status = writer(L, zeros, alignup(nameoffset) - nameoffset, ud);
+  }
+  for (i = 0; i < count && status == 0; i++) {  /* chunks */
+    size_t size = entries[i].chunksize;
+    lua_rawgeti(L, chunks, entries[i].chunkindex);
+    status = writer(L, lua_tostring(L, -1), size, ud);
+    lua_pop(L, 1);
+    if (status == 0 && alignup(size) > size)
+      status = writer(L, zeros, alignup(size) - size, ud);
+  }
+  lua_pop(L, 2);  /* entries, chunks */
+  return status;
+}
@@ -0,0 +1,73 @@
+/*
+** Tencent is pleased to support the open source community by making UnLua available.
+**
+** Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+**
+** Licensed under the MIT License (the "License");
+** you may not use this file except in compliance with the License. You may obtain a copy of the License at
+**
+** http://opensource.org/licenses/MIT
+**
+** Unless required by applicable law or agreed to in writing,
+** software distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and limitations under the License.
+*/
+
+/*
+** Indexed archive of precompiled Lua chunks.
+**
+** All integers are 32-bit little-endian.
+**
+**   header   "LPAK" | version | entry count | reserved
+**   entries  name offset | name size | chunk offset | chunk size   (sorted by name, bytewise)
+**   names    module names, not null-terminated
+**   chunks   output of lua_dump
+**
+** The archive is read in place, chunks are handed to lua_load straight from the archive memory so it
+** can be memory-mapped from disk.
+*/
+
+#ifndef lpak_h
+#define lpak_h
+
+#include <stddef.h>
+
+#include "lua.h"
+
+#define LPAK_MAGIC      "LPAK"
+#define LPAK_VERSION    1
+
+#define LPAK_NOTFOUND   (-1)
+
+typedef struct lpak_Archive {
+  const unsigned char *data;
+  size_t size;
+  unsigned int count;
+} lpak_Archive;
+
+/*
+** Validate an archive and prepare it for lookups. The memory must stay valid while the archive is used.
+** Returns 1 on success, 0 if the data isn't a valid archive.
+*/
+LUALIB_API int (lpak_open) (lpak_Archive *A, const void *data, size_t size);
+
+/*
+** Find the chunk of a module. Returns 1 and sets 'chunk'/'chunksize' if found, 0 otherwise.
+*/
+LUALIB_API int (lpak_find) (const lpak_Archive *A, const char *name, size_t namelen,
+                            const char **chunk, size_t *chunksize);
+
+/*
+** Load the chunk of a module as a Lua function without copying it. Returns the status of lua_load,
+** or LPAK_NOTFOUND (nothing pushed) if the module isn't in the archive.
+*/
+LUALIB_API int (lpak_load) (lua_State *L, const lpak_Archive *A, const char *name, const char *chunkname);
+
+/*
+** Write an archive for the table at 'idx', which maps module names to Lua functions.
+** Raises an error for invalid entries. Returns 0 on success or the first non-zero result of 'writer'.
+*/
+LUALIB_API int (lpak_dump) (lua_State *L, int idx, lua_Writer writer, void *ud, int strip);
+
+#endif
@@ -0,0 +1,179 @@
+/*
+** Tencent is pleased to support the open source community by making UnLua available.
+**
+** Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+**
+** Licensed under the MIT License (the "License");
+** you may not use this file except in compliance with the License. You may obtain a copy of the License at
+**
+** http://opensource.org/licenses/MIT
+**
+** Unless required by applicable law or agreed to in writing,
+** software distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and limitations under the License.
+*/
+
+/*
+** Tests of the precompiled chunk archive.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lua.h"
+#include "lauxlib.h"
+#include "lualib.h"
+
+#include "lpak.h"
+
+static int failures = 0;
+
+#define CHECK(cond) \
+  do { if (!(cond)) { fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+
+typedef struct MemBuffer {
+  char *data;
+  size_t size;
+} MemBuffer;
+
+
+static int memwriter (lua_State *L, const void *p, size_t size, void *ud) {
+  MemBuffer *b = (MemBuffer *)ud;
+  char *data = (char *)realloc(b->data, b->size + size);
+  (void)L;
+  if (data == NULL) return 1;
+  memcpy(data + b->size, p, size);
+  b->data = data;
+  b->size += size;
+  return 0;
+}
+
+
+static void addmodule (lua_State *L, const char *name, const char *source) {
+  int status = luaL_loadbufferx(L, source, strlen(source), name, "t");
+  CHECK(status == LUA_OK);
+  lua_setfield(L, -2, name);
+}
+
+
+static MemBuffer build (lua_State *L, int strip) {
+  MemBuffer b = {NULL, 0};
+  lua_newtable(L);
+  addmodule(L, "Main", "return 1");
+  addmodule(L, "UI.Button", "local M = {} function M.add(a, b) return a + b end return M");
+  addmodule(L, "UI", "return 'ui'");
+  addmodule(L, "Tutorials.BP_Player", "return ... or 'player'");
+  CHECK(lpak_dump(L, -1, memwriter, &b, strip) == 0);
+  lua_pop(L, 1);
+  return b;
+}
+
+
+static void test_roundtrip (lua_State *L, int strip) {
+  MemBuffer b = build(L, strip);
+  lpak_Archive A;
+  int top = lua_gettop(L);
+  CHECK(lpak_open(&A, b.data, b.size));
+  CHECK(A.count == 4);
+
+  CHECK(lpak_load(L, &A, "Main", NULL) == LUA_OK);
+  CHECK(lua_pcall(L, 0, 1, 0) == LUA_OK);
+  CHECK(lua_tointeger(L, -1) == 1);
+  lua_pop(L, 1);
+
+  CHECK(lpak_load(L, &A, "UI.Button", "@UI/Button.lua") == LUA_OK);
+  CHECK(lua_pcall(L, 0, 1, 0) == LUA_OK);
+  lua_getfield(L, -1, "add");
+  lua_pushinteger(L, 2);
+  lua_pushinteger(L, 3);
+  CHECK(lua_pcall(L, 2, 1, 0) == LUA_OK);
+  CHECK(lua_tointeger(L, -1) == 5);
+  lua_pop(L, 2);
+
+  CHECK(lpak_load(L, &A, "UI", NULL) == LUA_OK);
+  CHECK(lua_pcall(L, 0, 1, 0) == LUA_OK);
+  CHECK(strcmp(lua_tostring(L, -1), "ui") == 0);
+  lua_pop(L, 1);
+
+  CHECK(lpak_load(L, &A, "Tutorials.BP_Player", NULL) == LUA_OK);
+  CHECK(lua_pcall(L, 0, 1, 0) == LUA_OK);
+  CHECK(strcmp(lua_tostring(L, -1), "player") == 0);
+  lua_pop(L, 1);
+
+  CHECK(lpak_load(L, &A, "Missing", NULL) == LPAK_NOTFOUND);
+  CHECK(lpak_load(L, &A, "UI.", NULL) == LPAK_NOTFOUND);
+  CHECK(lpak_load(L, &A, "", NULL) == LPAK_NOTFOUND);
+  CHECK(lua_gettop(L) == top);
+  free(b.data);
+}
+
+
+static void test_invalid (lua_State *L) {
+  MemBuffer b = build(L, 1);
+  lpak_Archive A;
+  const char *chunk;
+  size_t size;
+
+  CHECK(!lpak_open(&A, NULL, 0));
+  CHECK(!lpak_open(&A, b.data, 8));
+  CHECK(!lpak_open(&A, b.data, 40));  /* truncated index */
+
+  b.data[0] = 'X';
+  CHECK(!lpak_open(&A, b.data, b.size));
+  b.data[0] = 'L';
+
+  b.data[4] = LPAK_VERSION + 1;
+  CHECK(!lpak_open(&A, b.data, b.size));
+  b.data[4] = LPAK_VERSION;
+
+  CHECK(lpak_open(&A, b.data, b.size));
+  CHECK(lpak_find(&A, "UI", 2, &chunk, &size));
+  CHECK(size > 0 && chunk[0] == LUA_SIGNATURE[0]);
+  free(b.data);
+
+  b.data = NULL;
+  b.size = 0;
+  lua_newtable(L);
+  CHECK(lpak_dump(L, -1, memwriter, &b, 1) == 0);  /* empty archive */
+  CHECK(lpak_open(&A, b.data, b.size));
+  CHECK(A.count == 0);
+  CHECK(lpak_load(L, &A, "Main", NULL) == LPAK_NOTFOUND);
+  lua_pop(L, 1);
+  free(b.data);
+}
+
+
+static int dumpinvalid (lua_State *L) {
+  MemBuffer b = {NULL, 0};
+  lua_newtable(L);
+  lua_pushinteger(L, 1);
+  lua_setfield(L, -2, "NotAFunction");
+  lpak_dump(L, -1, memwriter, &b, 1);
+  free(b.data);
+  return 0;
+}
+
+
+int main (void) {
+  lua_State *L = luaL_newstate();
+  luaL_openlibs(L);
+
+  test_roundtrip(L, 0);
+  test_roundtrip(L, 1);
+  test_invalid(L);
+
+  lua_pushcfunction(L, dumpinvalid);
+  CHECK(lua_pcall(L, 0, 0, 0) != LUA_OK);
+  lua_pop(L, 1);
+
+  lua_close(L);
+  if (failures > 0) {
+    fprintf(stderr, "%d check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all checks passed\n");
+  return EXIT_SUCCESS;
+}
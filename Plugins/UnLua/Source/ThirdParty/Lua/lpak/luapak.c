@@ -0,0 +1,110 @@
+/*
+** Tencent is pleased to support the open source community by making UnLua available.
+**
+** Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+**
+** Licensed under the MIT License (the "License");
+** you may not use this file except in compliance with the License. You may obtain a copy of the License at
+**
+** http://opensource.org/licenses/MIT
+**
+** Unless required by applicable law or agreed to in writing,
+** software distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and limitations under the License.
+*/
+
+/*
+** Command line tool to build an archive of precompiled Lua chunks.
+**
+**   luapak [-s] output root file...
+**
+** Module names are the paths of files relative to 'root', without the '.lua' extension and with
+** directory separators replaced by dots. '-s' strips debug information.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lua.h"
+#include "lauxlib.h"
+#include "lualib.h"
+
+#include "lpak.h"
+
+
+static int filewriter (lua_State *L, const void *p, size_t size, void *ud) {
+  (void)L;
+  return fwrite(p, 1, size, (FILE *)ud) != size;
+}
+
+
+static void pushmodulename (lua_State *L, const char *root, const char *file) {
+  size_t rootlen = strlen(root);
+  size_t len = strlen(file);
+  luaL_Buffer B;
+  size_t i;
+  if (strncmp(file, root, rootlen) == 0) {
+    file += rootlen;
+    len -= rootlen;
+    while (*file == '/' || *file == '\\') {
+      file++;
+      len--;
+    }
+  }
+  if (len > 4 && strcmp(file + len - 4, ".lua") == 0)
+    len -= 4;
+  luaL_buffinit(L, &B);
+  for (i = 0; i < len; i++)
+    luaL_addchar(&B, (file[i] == '/' || file[i] == '\\') ? '.' : file[i]);
+  luaL_pushresult(&B);
+}
+
+
+static int pmain (lua_State *L) {
+  int argc = (int)lua_tointeger(L, 1);
+  char **argv = (char **)lua_touserdata(L, 2);
+  int strip = 0, first = 1, i;
+  FILE *f;
+  if (argc > 1 && strcmp(argv[1], "-s") == 0) {
+    strip = 1;
+    first = 2;
+  }
+  if (argc - first < 2)
+    return luaL_error(L, "usage: %s [-s] output root file...", argv[0]);
+  lua_newtable(L);
+  for (i = first + 2; i < argc; i++) {
+    pushmodulename(L, argv[first + 1], argv[i]);
+    if (luaL_loadfilex(L, argv[i], "t") != LUA_OK)
+      return lua_error(L);
+    lua_rawset(L, -3);
+  }
+  f = fopen(argv[first], "wb");
+  if (f == NULL)
+    return luaL_error(L, "cannot open %s", argv[first]);
+  if (lpak_dump(L, -1, filewriter, f, strip) != 0 || ferror(f)) {
+    fclose(f);
+    return luaL_error(L, "cannot write %s", argv[first]);
+  }
+  fclose(f);
+  return 0;
+}
+
+
+int main (int argc, char **argv) {
+  lua_State *L = luaL_newstate();
+  int status;
+  if (L == NULL) {
+    fprintf(stderr, "%s: not enough memory\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  lua_pushcfunction(L, pmain);
+  lua_pushinteger(L, argc);
+  lua_pushlightuserdata(L, argv);
+  status = lua_pcall(L, 2, 0, 0);
+  if (status != LUA_OK)
+    fprintf(stderr, "%s: %s\n", argv[0], lua_tostring(L, -1));
+  lua_close(L);
+  return status == LUA_OK ? EXIT_SUCCESS : EXIT_FAILURE;
+}
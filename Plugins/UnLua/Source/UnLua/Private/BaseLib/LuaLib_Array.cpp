@@ -16,6 +16,8 @@
 #include "UnLuaEx.h"
 #include "LuaCore.h"
 #include "Containers/LuaArray.h"
+#include "Containers/LuaArrayKernels.h"
+#include "Containers/LuaArrayView.h"
 
 static FORCEINLINE void TArray_Guard(lua_State* L, FLuaArray* Array)
 {
@@ -42,30 +44,21 @@ static int32 TArray_New(lua_State* L)
     return 1;
 }
 
+/**
+ * Stateless iterator, the state is the array itself and the control variable is the 1-based index of last element
+ */
 static int TArray_Enumerable(lua_State* L)
 {
-    int32 NumParams = lua_gettop(L);
-
-    if (NumParams != 2)
-        return luaL_error(L, "invalid parameters");
-
-    FLuaArray::FLuaArrayEnumerator** Enumerator = (FLuaArray::FLuaArrayEnumerator**)(lua_touserdata(L, 1));
-
-    if (!Enumerator || !*Enumerator)
-        return luaL_error(L, "invalid enumerator");
-
-    const auto Array = (*Enumerator)->LuaArray;
+    FLuaArray* Array = (FLuaArray*)GetCppInstanceFast(L, 1);
     TArray_Guard(L, Array);
 
-    if (Array->IsValidIndex((*Enumerator)->Index))
-    {
-        UnLua::Push(L, (*Enumerator)->Index + 1);
-        Array->Inner->ReadValue(L, Array->GetData((*Enumerator)->Index), false);
-        (*Enumerator)->Index += 1;
-        return 2;
-    }
+    const int32 Index = (int32)lua_tointeger(L, 2);
+    if (!Array->IsValidIndex(Index))
+        return 0;
 
-    return 0;
+    lua_pushinteger(L, Index + 1);
+    Array->Inner->ReadValue(L, Array->GetData(Index), false);
+    return 2;
 }
 
 static int32 TArray_Pairs(lua_State* L)
@@ -81,16 +74,38 @@ static int32 TArray_Pairs(lua_State* L)
     TArray_Guard(L, Array);
 
     lua_pushcfunction(L, TArray_Enumerable);
-    FLuaArray::FLuaArrayEnumerator** Enumerator = (FLuaArray::FLuaArrayEnumerator**)lua_newuserdata(L, sizeof(FLuaArray::FLuaArrayEnumerator*));
-    *Enumerator = new FLuaArray::FLuaArrayEnumerator(Array, 0);
+    lua_pushvalue(L, 1);
+    lua_pushinteger(L, 0);
+    return 3;
+}
 
-    lua_newtable(L);
-    lua_pushcfunction(L, FLuaArray::FLuaArrayEnumerator::gc);
-    lua_setfield(L, -2, "__gc");
-    lua_setmetatable(L, -2);
-    lua_pushnil(L);
+/**
+ * Call a function for each element with (index, element), elements are passed by reference.
+ * Iteration stops if the function returns false.
+ */
+static int32 TArray_ForEach(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams != 2)
+        return luaL_error(L, "invalid parameters");
 
-    return 3;
+    FLuaArray* Array = (FLuaArray*)(GetCppInstanceFast(L, 1));
+    TArray_Guard(L, Array);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+
+    // the function may modify the array, so check the index every time
+    for (int32 i = 0; Array->IsValidIndex(i); ++i)
+    {
+        lua_pushvalue(L, 2);
+        lua_pushinteger(L, i + 1);
+        Array->Inner->ReadValue(L, Array->GetData(i), false);
+        lua_call(L, 2, 1);
+        const bool bBreak = lua_isboolean(L, -1) && !lua_toboolean(L, -1);
+        lua_pop(L, 1);
+        if (bBreak)
+            break;
+    }
+    return 0;
 }
 
 /**
@@ -487,6 +502,12 @@ static int32 TArray_Append(lua_State* L)
     FLuaArray* Array = (FLuaArray*)(GetCppInstanceFast(L, 1));
     TArray_Guard(L, Array);
 
+    if (lua_istable(L, 2))
+    {
+        UnLua::ArrayKernels::AppendTable(L, *Array, 2);
+        return 0;
+    }
+
     FLuaArray* SourceArray = (FLuaArray*)(GetCppInstanceFast(L, 2));
     TArray_Guard(L, SourceArray);
 
@@ -494,6 +515,43 @@ static int32 TArray_Append(lua_State* L)
     return 0;
 }
 
+/**
+ * Replace all elements with the sequence of a Lua table
+ */
+static int32 TArray_FromTable(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams != 2)
+        return luaL_error(L, "invalid parameters");
+
+    FLuaArray* Array = (FLuaArray*)(GetCppInstanceFast(L, 1));
+    TArray_Guard(L, Array);
+    luaL_checktype(L, 2, LUA_TTABLE);
+
+    Array->Clear();
+    UnLua::ArrayKernels::AppendTable(L, *Array, 2);
+    return 0;
+}
+
+/**
+ * Get a typed view which reads and writes the memory of a numeric array directly.
+ * Arrays of float structs (FVector etc.) are flattened, or viewed by the given member name.
+ */
+static int32 TArray_View(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams < 1 || NumParams > 2)
+        return luaL_error(L, "invalid parameters");
+
+    FLuaArray* Array = (FLuaArray*)(GetCppInstanceFast(L, 1));
+    TArray_Guard(L, Array);
+
+    const char* MemberName = NumParams > 1 ? luaL_checkstring(L, 2) : nullptr;
+    if (!UnLua::ArrayView::Push(L, 1, Array, MemberName))
+        return luaL_error(L, "can't create view for this array");
+    return 1;
+}
+
 /**
  * GC function
  */
@@ -526,16 +584,7 @@ static int32 TArray_ToTable(lua_State* L)
     FLuaArray* Array = (FLuaArray*)(GetCppInstanceFast(L, 1));
     TArray_Guard(L, Array);
 
-    lua_newtable(L);
-    Array->Inner->Initialize(Array->ElementCache);
-    for (int32 i = 0; i < Array->Num(); ++i)
-    {
-        lua_pushinteger(L, i + 1);
-        Array->Get(i, Array->ElementCache);
-        Array->Inner->ReadValue(L, Array->ElementCache, true);
-        lua_rawset(L, -3);
-    }
-    Array->Inner->Destruct(Array->ElementCache);
+    UnLua::ArrayKernels::ToTable(L, *Array);
     return 1;
 }
 
@@ -585,6 +634,9 @@ static const luaL_Reg TArrayLib[] =
     {"Contains", TArray_Contains},
     {"Append", TArray_Append},
     {"ToTable", TArray_ToTable},
+    {"FromTable", TArray_FromTable},
+    {"View", TArray_View},
+    {"ForEach", TArray_ForEach},
     {"__gc", TArray_Delete},
     {"__call", TArray_New},
     {"__pairs", TArray_Pairs},
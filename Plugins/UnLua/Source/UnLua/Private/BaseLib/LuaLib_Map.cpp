@@ -56,24 +56,21 @@ static int TMap_Enumerable(lua_State* L)
     if (NumParams != 2)
         return luaL_error(L, "invalid parameters");
 
-    FLuaMap::FLuaMapEnumerator** Enumerator = (FLuaMap::FLuaMapEnumerator**)(lua_touserdata(L, 1));
-    if (!Enumerator || !*Enumerator)
+    auto Enumerator = (FLuaMap::FLuaMapEnumerator*)lua_touserdata(L, 1);
+    if (!Enumerator)
         return luaL_error(L, "invalid enumerator");
 
-    const auto Map = (*Enumerator)->LuaMap;
+    const auto Map = Enumerator->LuaMap;
     TMap_Guard(L, Map);
 
-    while ((*Enumerator)->Index < Map->GetMaxIndex())
+    const int32 MaxIndex = Map->GetMaxIndex();
+    while (Enumerator->Index < MaxIndex)
     {
-        if (!Map->IsValidIndex((*Enumerator)->Index))
+        const int32 Index = Enumerator->Index++;
+        if (Map->IsValidIndex(Index))
         {
-            ++(*Enumerator)->Index;
-        }
-        else
-        {
-            Map->KeyInterface->ReadValue(L, Map->GetData((*Enumerator)->Index), false);
-            Map->ValueInterface->ReadValue(L, Map->GetData((*Enumerator)->Index) + Map->MapLayout.ValueOffset, false);
-            ++(*Enumerator)->Index;
+            Map->KeyInterface->ReadValue(L, Map->GetData(Index), false);
+            Map->ValueInterface->ReadValue(L, Map->GetData(Index) + Map->MapLayout.ValueOffset, false);
             return 2;
         }
     }
@@ -93,19 +90,50 @@ static int32 TMap_Pairs(lua_State* L)
 
     TMap_Guard(L, Map);
 
+    // the control variable must be the key, so keep the position in a plain userdata which anchors the map as user value
     lua_pushcfunction(L, TMap_Enumerable);
-    FLuaMap::FLuaMapEnumerator** Enumerator = (FLuaMap::FLuaMapEnumerator**)lua_newuserdata(L, sizeof(FLuaMap::FLuaMapEnumerator*));
-    *Enumerator = new FLuaMap::FLuaMapEnumerator(Map, 0);
-
-    lua_newtable(L);
-    lua_pushcfunction(L, FLuaMap::FLuaMapEnumerator::gc);
-    lua_setfield(L, -2, "__gc");
-    lua_setmetatable(L, -2);
+    auto Enumerator = (FLuaMap::FLuaMapEnumerator*)lua_newuserdata(L, sizeof(FLuaMap::FLuaMapEnumerator));
+    Enumerator->LuaMap = Map;
+    Enumerator->Index = 0;
+    lua_pushvalue(L, 1);
+    lua_setuservalue(L, -2);
     lua_pushnil(L);
 
     return 3;
 }
 
+/**
+ * Call a function for each pair with (key, value), pairs are passed by reference.
+ * Iteration stops if the function returns false.
+ */
+static int32 TMap_ForEach(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams != 2)
+        return luaL_error(L, "invalid parameters");
+
+    FLuaMap* Map = (FLuaMap*)(GetCppInstanceFast(L, 1));
+    TMap_Guard(L, Map);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+
+    // the function may modify the map, so check the index every time
+    for (int32 i = 0; i < Map->GetMaxIndex(); ++i)
+    {
+        if (!Map->IsValidIndex(i))
+            continue;
+
+        lua_pushvalue(L, 2);
+        Map->KeyInterface->ReadValue(L, Map->GetData(i), false);
+        Map->ValueInterface->ReadValue(L, Map->GetData(i) + Map->MapLayout.ValueOffset, false);
+        lua_call(L, 2, 1);
+        const bool bBreak = lua_isboolean(L, -1) && !lua_toboolean(L, -1);
+        lua_pop(L, 1);
+        if (bBreak)
+            break;
+    }
+    return 0;
+}
+
 /**
  * @see FLuaMap::Num(...)
  */
@@ -346,6 +374,7 @@ static const luaL_Reg TMapLib[] =
     {"Keys", TMap_Keys},
     {"Values", TMap_Values},
     {"ToTable", TMap_ToTable},
+    {"ForEach", TMap_ForEach},
     {"__gc", TMap_Delete},
     {"__call", TMap_New},
     {"__pairs", TMap_Pairs},
@@ -12,6 +12,7 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
 // See the License for the specific language governing permissions and limitations under the License.
 
+#include "LowLevel.h"
 #include "UnLuaEx.h"
 #include "LuaCore.h"
 #include "Containers/LuaSet.h"
@@ -42,6 +43,77 @@ static int32 TSet_New(lua_State* L)
     return 1;
 }
 
+/**
+ * Stateless iterator, the state is the set itself and the control variable is the 1-based sparse index of last element
+ */
+static int TSet_Enumerable(lua_State* L)
+{
+    FLuaSet* Set = (FLuaSet*)GetCppInstanceFast(L, 1);
+    TSet_Guard(L, Set);
+
+    const int32 MaxIndex = Set->GetMaxIndex();
+    for (int32 Index = (int32)lua_tointeger(L, 2); Index < MaxIndex; ++Index)
+    {
+        if (!Set->IsValidIndex(Index))
+            continue;
+
+        lua_pushinteger(L, Index + 1);
+        Set->ElementInterface->ReadValue(L, Set->GetData(Index), false);
+        return 2;
+    }
+
+    return 0;
+}
+
+static int32 TSet_Pairs(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams != 1)
+        return luaL_error(L, "invalid parameters");
+
+    FLuaSet* Set = (FLuaSet*)GetCppInstanceFast(L, 1);
+    if (!Set)
+        return UnLua::LowLevel::PushEmptyIterator(L);
+
+    TSet_Guard(L, Set);
+
+    lua_pushcfunction(L, TSet_Enumerable);
+    lua_pushvalue(L, 1);
+    lua_pushinteger(L, 0);
+    return 3;
+}
+
+/**
+ * Call a function for each element, elements are passed by reference.
+ * Iteration stops if the function returns false.
+ */
+static int32 TSet_ForEach(lua_State* L)
+{
+    int32 NumParams = lua_gettop(L);
+    if (NumParams != 2)
+        return luaL_error(L, "invalid parameters");
+
+    FLuaSet* Set = (FLuaSet*)(GetCppInstanceFast(L, 1));
+    TSet_Guard(L, Set);
+    luaL_checktype(L, 2, LUA_TFUNCTION);
+
+    // the function may modify the set, so check the index every time
+    for (int32 i = 0; i < Set->GetMaxIndex(); ++i)
+    {
+        if (!Set->IsValidIndex(i))
+            continue;
+
+        lua_pushvalue(L, 2);
+        Set->ElementInterface->ReadValue(L, Set->GetData(i), false);
+        lua_call(L, 1, 1);
+        const bool bBreak = lua_isboolean(L, -1) && !lua_toboolean(L, -1);
+        lua_pop(L, 1);
+        if (bBreak)
+            break;
+    }
+    return 0;
+}
+
 /**
  * @see FLuaSet::Num(...)
  */
@@ -208,8 +280,10 @@ static const luaL_Reg TSetLib[] =
     {"Clear", TSet_Clear},
     {"ToArray", TSet_ToArray},
     {"ToTable", TSet_ToTable},
+    {"ForEach", TSet_ForEach},
     {"__gc", TSet_Delete},
     {"__call", TSet_New},
+    {"__pairs", TSet_Pairs},
     {nullptr, nullptr}
 };
 
@@ -0,0 +1,378 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaArrayKernels.h"
+#include "LuaArray.h"
+#include "LuaCore.h"
+#include "LuaEnv.h"
+#include "LowLevel.h"
+#include "ReflectionUtils/PropertyDesc.h"
+
+namespace UnLua
+{
+    namespace ArrayKernels
+    {
+        static bool IsFloatStruct(const UScriptStruct* Struct)
+        {
+            const auto CppStructOps = Struct->GetCppStructOps();
+            if (CppStructOps && !CppStructOps->IsPlainOldData())
+                return false;
+
+            int32 NumMembers = 0;
+            for (TFieldIterator<FProperty> It(Struct); It; ++It)
+            {
+                const auto Type = GetPropertyType(*It);
+                if (It->ArrayDim != 1 || (Type != CPT_Float && Type != CPT_Double))
+                    return false;
+                ++NumMembers;
+            }
+            return NumMembers > 0;
+        }
+
+        EElementKind GetElementKind(const FLuaArray& Array)
+        {
+            const FProperty* Property = Array.Inner->GetUProperty();
+            if (!Property || Property->ArrayDim != 1)
+                return EElementKind::Generic;
+
+            switch (GetPropertyType(Property))
+            {
+            case CPT_Bool:
+                return CastFieldChecked<FBoolProperty>(Property)->IsNativeBool() ? EElementKind::Bool : EElementKind::Generic;
+            case CPT_Int8:
+                return EElementKind::Int8;
+            case CPT_Byte:
+                return EElementKind::UInt8;
+            case CPT_Int16:
+                return EElementKind::Int16;
+            case CPT_UInt16:
+                return EElementKind::UInt16;
+            case CPT_Int:
+                return EElementKind::Int32;
+            case CPT_UInt32:
+                return EElementKind::UInt32;
+            case CPT_Int64:
+                return EElementKind::Int64;
+            case CPT_UInt64:
+                return EElementKind::UInt64;
+            case CPT_Float:
+                return EElementKind::Float;
+            case CPT_Double:
+                return EElementKind::Double;
+            case CPT_Name:
+                return EElementKind::Name;
+            case CPT_String:
+                return EElementKind::String;
+            case CPT_Struct:
+                return IsFloatStruct(CastFieldChecked<FStructProperty>(Property)->Struct) ? EElementKind::FloatStruct : EElementKind::Generic;
+            default:
+                return EElementKind::Generic;
+            }
+        }
+
+        template <typename T>
+        static void IntegersToTable(lua_State* L, const FLuaArray& Array)
+        {
+            const T* Src = (const T*)Array.GetData();
+            for (int32 i = 0, Num = Array.Num(); i < Num; ++i)
+            {
+                lua_pushinteger(L, (lua_Integer)Src[i]);
+                lua_rawseti(L, -2, i + 1);
+            }
+        }
+
+        template <typename T>
+        static void NumbersToTable(lua_State* L, const FLuaArray& Array)
+        {
+            const T* Src = (const T*)Array.GetData();
+            for (int32 i = 0, Num = Array.Num(); i < Num; ++i)
+            {
+                lua_pushnumber(L, (lua_Number)Src[i]);
+                lua_rawseti(L, -2, i + 1);
+            }
+        }
+
+        static bool FloatStructsToTable(lua_State* L, const FLuaArray& Array)
+        {
+            const auto Struct = CastFieldChecked<FStructProperty>(Array.Inner->GetUProperty())->Struct;
+            if (IsValueStruct(Struct))
+                return false;
+
+            const auto ClassDesc = FClassRegistry::RegisterReflectedType(Struct);
+            if (!ClassDesc)
+                return false;
+
+            const auto MetatableName = LowLevel::GetMetatableName(Struct);
+            if (!FLuaEnv::FindEnvChecked(L).GetClassRegistry()->PushMetatable(L, TCHAR_TO_UTF8(*MetatableName)))
+                return false;
+
+            // same layout as the userdata created by FScriptStructPropertyDesc, the metatable is looked up only once
+            const int32 Size = ClassDesc->GetSize();
+            const uint8 Padding = ClassDesc->GetUserdataPadding();
+            const uint8* Src = (const uint8*)Array.GetData();
+            for (int32 i = 0, Num = Array.Num(); i < Num; ++i)
+            {
+                uint8* Userdata = (uint8*)NewUserdataWithPaddingTag(L, Size, Padding) + Padding;
+                FMemory::Memcpy(Userdata, Src, Size);
+                Src += Array.ElementSize;
+                lua_pushvalue(L, -2);
+                lua_setmetatable(L, -2);
+                lua_rawseti(L, -3, i + 1);
+            }
+            lua_pop(L, 1);
+            return true;
+        }
+
+        void ToTable(lua_State* L, FLuaArray& Array)
+        {
+            const int32 Num = Array.Num();
+            lua_createtable(L, Num, 0);
+            if (Num == 0)
+                return;
+
+            switch (GetElementKind(Array))
+            {
+            case EElementKind::Bool:
+                {
+                    const bool* Src = (const bool*)Array.GetData();
+                    for (int32 i = 0; i < Num; ++i)
+                    {
+                        lua_pushboolean(L, Src[i]);
+                        lua_rawseti(L, -2, i + 1);
+                    }
+                    return;
+                }
+            case EElementKind::Int8:
+                IntegersToTable<int8>(L, Array);
+                return;
+            case EElementKind::UInt8:
+                IntegersToTable<uint8>(L, Array);
+                return;
+            case EElementKind::Int16:
+                IntegersToTable<int16>(L, Array);
+                return;
+            case EElementKind::UInt16:
+                IntegersToTable<uint16>(L, Array);
+                return;
+            case EElementKind::Int32:
+                IntegersToTable<int32>(L, Array);
+                return;
+            case EElementKind::UInt32:
+                IntegersToTable<uint32>(L, Array);
+                return;
+            case EElementKind::Int64:
+                IntegersToTable<int64>(L, Array);
+                return;
+            case EElementKind::UInt64:
+                IntegersToTable<uint64>(L, Array);
+                return;
+            case EElementKind::Float:
+                NumbersToTable<float>(L, Array);
+                return;
+            case EElementKind::Double:
+                NumbersToTable<double>(L, Array);
+                return;
+            case EElementKind::Name:
+                {
+                    const FName* Src = (const FName*)Array.GetData();
+                    const auto NameCache = FLuaEnv::FindEnvChecked(L).GetNameCache();
+                    for (int32 i = 0; i < Num; ++i)
+                    {
+                        NameCache->Push(L, Src[i]);
+                        lua_rawseti(L, -2, i + 1);
+                    }
+                    return;
+                }
+            case EElementKind::String:
+                {
+                    const FString* Src = (const FString*)Array.GetData();
+                    for (int32 i = 0; i < Num; ++i)
+                    {
+                        const FTCHARToUTF8 Utf8(*Src[i]);
+                        lua_pushlstring(L, Utf8.Get(), Utf8.Length());
+                        lua_rawseti(L, -2, i + 1);
+                    }
+                    return;
+                }
+            case EElementKind::FloatStruct:
+                if (FloatStructsToTable(L, Array))
+                    return;
+                break;
+            default:
+                break;
+            }
+
+            for (int32 i = 0; i < Num; ++i)
+            {
+                Array.Inner->ReadValue(L, Array.GetData(i), true);
+                lua_rawseti(L, -2, i + 1);
+            }
+        }
+
+        template <typename T>
+        static void AppendIntegers(lua_State* L, FLuaArray& Array, int32 TableIndex, int32 Count)
+        {
+            T* Dest = (T*)Array.GetData(Array.AddUninitialized(Count));
+            for (int32 i = 0; i < Count; ++i)
+            {
+                lua_rawgeti(L, TableIndex, i + 1);
+                Dest[i] = (T)lua_tointeger(L, -1);
+                lua_pop(L, 1);
+            }
+        }
+
+        template <typename T>
+        static void AppendNumbers(lua_State* L, FLuaArray& Array, int32 TableIndex, int32 Count)
+        {
+            T* Dest = (T*)Array.GetData(Array.AddUninitialized(Count));
+            for (int32 i = 0; i < Count; ++i)
+            {
+                lua_rawgeti(L, TableIndex, i + 1);
+                Dest[i] = (T)lua_tonumber(L, -1);
+                lua_pop(L, 1);
+            }
+        }
+
+        static bool AppendFloatStructs(lua_State* L, FLuaArray& Array, int32 TableIndex, int32 Count)
+        {
+            const auto Struct = CastFieldChecked<FStructProperty>(Array.Inner->GetUProperty())->Struct;
+            const auto MetatableName = LowLevel::GetMetatableName(Struct);
+            if (luaL_getmetatable(L, TCHAR_TO_UTF8(*MetatableName)) != LUA_TTABLE)
+            {
+                lua_pop(L, 1);
+                return false;
+            }
+
+            const int32 Size = Array.ElementSize;
+            uint8* Dest = Array.GetData(Array.AddUninitialized(Count));
+            for (int32 i = 0; i < Count; ++i, Dest += Size)
+            {
+                lua_rawgeti(L, TableIndex, i + 1);
+                const void* Src = nullptr;
+                if (lua_getmetatable(L, -1))
+                {
+                    if (lua_rawequal(L, -1, -3))
+                        Src = GetCppInstanceFast(L, -2);
+                    lua_pop(L, 1);
+                }
+
+                if (Src)
+                {
+                    FMemory::Memcpy(Dest, Src, Size);
+                }
+                else
+                {
+                    Array.Inner->Initialize(Dest);
+                    Array.Inner->WriteValue(L, Dest, lua_gettop(L), true);
+                }
+                lua_pop(L, 1);
+            }
+            lua_pop(L, 1);
+            return true;
+        }
+
+        void AppendTable(lua_State* L, FLuaArray& Array, int32 TableIndex)
+        {
+            TableIndex = lua_absindex(L, TableIndex);
+            const int32 Count = (int32)lua_rawlen(L, TableIndex);
+            if (Count <= 0)
+                return;
+
+            switch (GetElementKind(Array))
+            {
+            case EElementKind::Bool:
+                {
+                    bool* Dest = (bool*)Array.GetData(Array.AddUninitialized(Count));
+                    for (int32 i = 0; i < Count; ++i)
+                    {
+                        lua_rawgeti(L, TableIndex, i + 1);
+                        Dest[i] = lua_toboolean(L, -1) != 0;
+                        lua_pop(L, 1);
+                    }
+                    return;
+                }
+            case EElementKind::Int8:
+                AppendIntegers<int8>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::UInt8:
+                AppendIntegers<uint8>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::Int16:
+                AppendIntegers<int16>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::UInt16:
+                AppendIntegers<uint16>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::Int32:
+                AppendIntegers<int32>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::UInt32:
+                AppendIntegers<uint32>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::Int64:
+                AppendIntegers<int64>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::UInt64:
+                AppendIntegers<uint64>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::Float:
+                AppendNumbers<float>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::Double:
+                AppendNumbers<double>(L, Array, TableIndex, Count);
+                return;
+            case EElementKind::Name:
+                {
+                    FName* Dest = (FName*)Array.GetData(Array.AddUninitialized(Count));
+                    const auto NameCache = FLuaEnv::FindEnvChecked(L).GetNameCache();
+                    for (int32 i = 0; i < Count; ++i)
+                    {
+                        lua_rawgeti(L, TableIndex, i + 1);
+                        new(Dest + i) FName(NameCache->Get(L, -1));
+                        lua_pop(L, 1);
+                    }
+                    return;
+                }
+            case EElementKind::String:
+                {
+                    FString* Dest = (FString*)Array.GetData(Array.AddUninitialized(Count));
+                    for (int32 i = 0; i < Count; ++i)
+                    {
+                        lua_rawgeti(L, TableIndex, i + 1);
+                        size_t Len = 0;
+                        const char* Str = lua_tolstring(L, -1, &Len);
+                        const FUTF8ToTCHAR Converted(Str ? Str : "", Len);
+                        new(Dest + i) FString(Converted.Length(), Converted.Get());
+                        lua_pop(L, 1);
+                    }
+                    return;
+                }
+            case EElementKind::FloatStruct:
+                if (AppendFloatStructs(L, Array, TableIndex, Count))
+                    return;
+                break;
+            default:
+                break;
+            }
+
+            uint8* Dest = Array.GetData(Array.AddDefaulted(Count));
+            for (int32 i = 0; i < Count; ++i, Dest += Array.ElementSize)
+            {
+                lua_rawgeti(L, TableIndex, i + 1);
+                Array.Inner->WriteValue(L, Dest, lua_gettop(L), true);
+                lua_pop(L, 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+class FLuaArray;
+
+namespace UnLua
+{
+    /**
+     * Bulk transfer between TArray and Lua table, specialized by element type to avoid virtual dispatch and
+     * per-element copies through the element cache.
+     */
+    namespace ArrayKernels
+    {
+        enum class EElementKind : uint8
+        {
+            Generic,
+            Bool,
+            Int8,
+            UInt8,
+            Int16,
+            UInt16,
+            Int32,
+            UInt32,
+            Int64,
+            UInt64,
+            Float,
+            Double,
+            Name,
+            String,
+            FloatStruct,    // script struct which only contains float/double members, FVector/FRotator etc.
+        };
+
+        EElementKind GetElementKind(const FLuaArray& Array);
+
+        /**
+         * Push a Lua table which contains copies of all elements
+         */
+        void ToTable(lua_State* L, FLuaArray& Array);
+
+        /**
+         * Append elements in the sequence of the Lua table at the given index
+         */
+        void AppendTable(lua_State* L, FLuaArray& Array, int32 TableIndex);
+    }
+}
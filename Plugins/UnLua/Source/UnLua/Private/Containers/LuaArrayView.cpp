@@ -0,0 +1,404 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaArrayView.h"
+#include "LuaArray.h"
+#include "LuaArrayKernels.h"
+#include "LuaCore.h"
+#include "ReflectionUtils/PropertyDesc.h"
+
+namespace UnLua
+{
+    namespace ArrayView
+    {
+        using ArrayKernels::EElementKind;
+
+        static const char* VIEW_METATABLE = "TArrayView";
+
+        struct FView
+        {
+            FLuaArray* Array;
+            int32 Offset;           // offset of the first item in bytes
+            int32 Stride;           // distance between two items in bytes
+            int32 ItemsPerElement;  // number of items in one element, greater than 1 for flattened struct components
+            EElementKind Kind;
+
+            FORCEINLINE int32 Num() const { return Array->Num() * ItemsPerElement; }
+
+            FORCEINLINE uint8* GetData() const { return (uint8*)Array->GetData() + Offset; }
+
+            FORCEINLINE uint8* GetItem(int32 Index) const { return GetData() + (SIZE_T)Index * Stride; }
+        };
+
+#define DISPATCH_VIEW_KIND(Kind, Func, ...) \
+        switch (Kind) \
+        { \
+        case EElementKind::Int8: Func<int8>(__VA_ARGS__); break; \
+        case EElementKind::UInt8: Func<uint8>(__VA_ARGS__); break; \
+        case EElementKind::Int16: Func<int16>(__VA_ARGS__); break; \
+        case EElementKind::UInt16: Func<uint16>(__VA_ARGS__); break; \
+        case EElementKind::Int32: Func<int32>(__VA_ARGS__); break; \
+        case EElementKind::UInt32: Func<uint32>(__VA_ARGS__); break; \
+        case EElementKind::Int64: Func<int64>(__VA_ARGS__); break; \
+        case EElementKind::UInt64: Func<uint64>(__VA_ARGS__); break; \
+        case EElementKind::Float: Func<float>(__VA_ARGS__); break; \
+        case EElementKind::Double: Func<double>(__VA_ARGS__); break; \
+        default: checkNoEntry(); break; \
+        }
+
+        static int32 GetItemSize(EElementKind Kind)
+        {
+            switch (Kind)
+            {
+            case EElementKind::Int8:
+            case EElementKind::UInt8:
+                return 1;
+            case EElementKind::Int16:
+            case EElementKind::UInt16:
+                return 2;
+            case EElementKind::Int32:
+            case EElementKind::UInt32:
+            case EElementKind::Float:
+                return 4;
+            case EElementKind::Int64:
+            case EElementKind::UInt64:
+            case EElementKind::Double:
+                return 8;
+            default:
+                return 0;
+            }
+        }
+
+        static FORCEINLINE bool IsFloatingPoint(EElementKind Kind)
+        {
+            return Kind == EElementKind::Float || Kind == EElementKind::Double;
+        }
+
+        /**
+         * Get the view and check that the array it refers to is still alive, the array userdata in the uservalue
+         * may have been released (e.g. by DanglingCheck) after the view was created.
+         */
+        static FView& CheckView(lua_State* L, int32 Index)
+        {
+            FView& View = *(FView*)luaL_checkudata(L, Index, VIEW_METATABLE);
+            lua_getuservalue(L, Index);
+            const auto Array = (FLuaArray*)GetCppInstanceFast(L, -1);
+            lua_pop(L, 1);
+
+            if (!Array)
+                luaL_error(L, "invalid TArray");
+
+            if (!Array->Inner->IsValid())
+                luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("invalid TArray element type:%s"), *Array->Inner->GetName())));
+
+            View.Array = Array;
+            return View;
+        }
+
+        template <typename T>
+        static void PushItem(lua_State* L, const FView& View, int32 Index)
+        {
+            const T Value = *(const T*)View.GetItem(Index);
+            if (TIsFloatingPoint<T>::Value)
+                lua_pushnumber(L, (lua_Number)Value);
+            else
+                lua_pushinteger(L, (lua_Integer)Value);
+        }
+
+        template <typename T>
+        static void SetItem(lua_State* L, const FView& View, int32 Index, int32 ValueIndex)
+        {
+            T* Item = (T*)View.GetItem(Index);
+            if (TIsFloatingPoint<T>::Value)
+                *Item = (T)lua_tonumber(L, ValueIndex);
+            else
+                *Item = (T)lua_tointeger(L, ValueIndex);
+        }
+
+        /**
+         * Sum of all items. Contiguous items are accumulated in 4 lanes so that the loop can be vectorized.
+         */
+        template <typename T>
+        static void Sum(lua_State* L, const FView& View)
+        {
+            typedef typename TChooseClass<TIsFloatingPoint<T>::Value, double, int64>::Result FAccumulator;
+            const int32 Num = View.Num();
+            FAccumulator Result = 0;
+            if (View.Stride == sizeof(T))
+            {
+                const T* RESTRICT Data = (const T*)View.GetData();
+                FAccumulator Lanes[4] = {0, 0, 0, 0};
+                int32 i = 0;
+                for (; i + 4 <= Num; i += 4)
+                {
+                    Lanes[0] += Data[i];
+                    Lanes[1] += Data[i + 1];
+                    Lanes[2] += Data[i + 2];
+                    Lanes[3] += Data[i + 3];
+                }
+                for (; i < Num; ++i)
+                    Result += Data[i];
+                Result += (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+            }
+            else
+            {
+                for (int32 i = 0; i < Num; ++i)
+                    Result += *(const T*)View.GetItem(i);
+            }
+
+            if (TIsFloatingPoint<T>::Value)
+                lua_pushnumber(L, (lua_Number)Result);
+            else
+                lua_pushinteger(L, (lua_Integer)Result);
+        }
+
+        template <typename T>
+        static void Scale(lua_State* L, const FView& View, double Factor)
+        {
+            typedef typename TChooseClass<TIsFloatingPoint<T>::Value, T, double>::Result FFactor;
+            const FFactor F = (FFactor)Factor;
+            const int32 Num = View.Num();
+            if (View.Stride == sizeof(T))
+            {
+                T* RESTRICT Data = (T*)View.GetData();
+                for (int32 i = 0; i < Num; ++i)
+                    Data[i] = (T)(Data[i] * F);
+            }
+            else
+            {
+                for (int32 i = 0; i < Num; ++i)
+                {
+                    T* Item = (T*)View.GetItem(i);
+                    *Item = (T)(*Item * F);
+                }
+            }
+        }
+
+        template <typename T>
+        static void Fill(lua_State* L, const FView& View, int32 ValueIndex)
+        {
+            const T Value = TIsFloatingPoint<T>::Value ? (T)lua_tonumber(L, ValueIndex) : (T)lua_tointeger(L, ValueIndex);
+            const int32 Num = View.Num();
+            if (View.Stride == sizeof(T))
+            {
+                T* RESTRICT Data = (T*)View.GetData();
+                for (int32 i = 0; i < Num; ++i)
+                    Data[i] = Value;
+            }
+            else
+            {
+                for (int32 i = 0; i < Num; ++i)
+                    *(T*)View.GetItem(i) = Value;
+            }
+        }
+
+        template <typename T, typename TValue>
+        static FORCEINLINE void ReadAs(const FView& View, int32 Index, TValue& Value)
+        {
+            Value = (TValue)*(const T*)View.GetItem(Index);
+        }
+
+        template <typename T, typename TValue>
+        static FORCEINLINE void WriteAs(const FView& View, int32 Index, TValue Value)
+        {
+            *(T*)View.GetItem(Index) = (T)Value;
+        }
+
+        template <typename TValue>
+        static void CopyItems(const FView& Dest, const FView& Src, int32 Num)
+        {
+            for (int32 i = 0; i < Num; ++i)
+            {
+                TValue Value = 0;
+                DISPATCH_VIEW_KIND(Src.Kind, ReadAs, Src, i, Value)
+                DISPATCH_VIEW_KIND(Dest.Kind, WriteAs, Dest, i, Value)
+            }
+        }
+
+        static int View_Index(lua_State* L)
+        {
+            const FView& View = CheckView(L, 1);
+            if (!lua_isinteger(L, 2))
+            {
+                lua_pushvalue(L, 2);
+                lua_rawget(L, lua_upvalueindex(1));
+                return 1;
+            }
+
+            const int32 Index = (int32)lua_tointeger(L, 2) - 1;
+            if (Index < 0 || Index >= View.Num())
+                return 0;
+
+            DISPATCH_VIEW_KIND(View.Kind, PushItem, L, View, Index)
+            return 1;
+        }
+
+        static int View_NewIndex(lua_State* L)
+        {
+            const FView& View = CheckView(L, 1);
+            const int32 Index = (int32)luaL_checkinteger(L, 2) - 1;
+            if (Index < 0 || Index >= View.Num())
+                return luaL_error(L, "TArrayView index %d out of range", Index + 1);
+
+            DISPATCH_VIEW_KIND(View.Kind, SetItem, L, View, Index, 3)
+            return 0;
+        }
+
+        static int View_Num(lua_State* L)
+        {
+            const FView& View = CheckView(L, 1);
+            lua_pushinteger(L, View.Num());
+            return 1;
+        }
+
+        static int View_Stride(lua_State* L)
+        {
+            const FView& View = CheckView(L, 1);
+            lua_pushinteger(L, View.Stride);
+            return 1;
+        }
+
+        static int View_Sum(lua_State* L)
+        {
+            const FView& View = CheckView(L, 1);
+            DISPATCH_VIEW_KIND(View.Kind, Sum, L, View)
+            return 1;
+        }
+
+        static int View_Scale(lua_State* L)
+        {
+            const FView& View = CheckView(L, 1);
+            const double Factor = luaL_checknumber(L, 2);
+            DISPATCH_VIEW_KIND(View.Kind, Scale, L, View, Factor)
+            return 0;
+        }
+
+        static int View_Fill(lua_State* L)
+        {
+            const FView& View = CheckView(L, 1);
+            luaL_checknumber(L, 2);
+            DISPATCH_VIEW_KIND(View.Kind, Fill, L, View, 2)
+            return 0;
+        }
+
+        static int View_CopyFrom(lua_State* L)
+        {
+            const FView& Dest = CheckView(L, 1);
+            const FView& Src = CheckView(L, 2);
+            const int32 Num = Dest.Num();
+            if (Src.Num() != Num)
+                return luaL_error(L, "TArrayView length mismatch, %d expected but got %d", Num, Src.Num());
+
+            const int32 ItemSize = GetItemSize(Dest.Kind);
+            if (Dest.Kind == Src.Kind && Dest.Stride == ItemSize && Src.Stride == ItemSize)
+            {
+                FMemory::Memmove(Dest.GetData(), Src.GetData(), (SIZE_T)Num * ItemSize);
+                return 0;
+            }
+
+            if (IsFloatingPoint(Dest.Kind) || IsFloatingPoint(Src.Kind))
+                CopyItems<double>(Dest, Src, Num);
+            else
+                CopyItems<int64>(Dest, Src, Num);
+            return 0;
+        }
+
+        static const luaL_Reg ViewLib[] =
+        {
+            {"Num", View_Num},
+            {"Length", View_Num},
+            {"Stride", View_Stride},
+            {"Sum", View_Sum},
+            {"Scale", View_Scale},
+            {"Fill", View_Fill},
+            {"CopyFrom", View_CopyFrom},
+            {nullptr, nullptr}
+        };
+
+        static void PushMetatable(lua_State* L)
+        {
+            if (!luaL_newmetatable(L, VIEW_METATABLE))
+                return;
+
+            lua_newtable(L);
+            luaL_setfuncs(L, ViewLib, 0);
+            lua_pushcclosure(L, View_Index, 1);
+            lua_setfield(L, -2, "__index");
+            lua_pushcfunction(L, View_NewIndex);
+            lua_setfield(L, -2, "__newindex");
+            lua_pushcfunction(L, View_Num);
+            lua_setfield(L, -2, "__len");
+        }
+
+        static bool InitView(FView& View, FLuaArray* Array, const char* MemberName)
+        {
+            View.Array = Array;
+            View.Kind = ArrayKernels::GetElementKind(*Array);
+            View.Offset = 0;
+            View.Stride = Array->ElementSize;
+            View.ItemsPerElement = 1;
+
+            if (View.Kind != EElementKind::FloatStruct)
+                return GetItemSize(View.Kind) > 0 && !MemberName;
+
+            const auto Struct = CastFieldChecked<FStructProperty>(Array->Inner->GetUProperty())->Struct;
+            if (MemberName)
+            {
+                const auto Member = Struct->FindPropertyByName(FName(UTF8_TO_TCHAR(MemberName)));
+                if (!Member)
+                    return false;
+                View.Kind = GetPropertyType(Member) == CPT_Float ? EElementKind::Float : EElementKind::Double;
+                View.Offset = Member->GetOffset_ForInternal();
+                return true;
+            }
+
+            // flatten all components, they must be of the same type and tightly packed
+            int32 NumMembers = 0;
+            int32 MemberType = CPT_None;
+            for (TFieldIterator<FProperty> It(Struct); It; ++It)
+            {
+                const int32 Type = GetPropertyType(*It);
+                if (NumMembers > 0 && Type != MemberType)
+                    return false;
+                if (It->GetOffset_ForInternal() != NumMembers * It->ElementSize)
+                    return false;
+                MemberType = Type;
+                ++NumMembers;
+            }
+
+            View.Kind = MemberType == CPT_Float ? EElementKind::Float : EElementKind::Double;
+            View.Stride = GetItemSize(View.Kind);
+            View.ItemsPerElement = NumMembers;
+            return NumMembers * View.Stride == Array->ElementSize;
+        }
+
+        bool Push(lua_State* L, int32 ArrayIndex, FLuaArray* Array, const char* MemberName)
+        {
+            FView View;
+            if (!InitView(View, Array, MemberName))
+                return false;
+
+            ArrayIndex = lua_absindex(L, ArrayIndex);
+            auto Userdata = (FView*)lua_newuserdata(L, sizeof(FView));
+            *Userdata = View;
+            lua_pushvalue(L, ArrayIndex);
+            lua_setuservalue(L, -2);    // keep the array alive
+            PushMetatable(L);
+            lua_setmetatable(L, -2);
+            return true;
+        }
+
+#undef DISPATCH_VIEW_KIND
+    }
+}
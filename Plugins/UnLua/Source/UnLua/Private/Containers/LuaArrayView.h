@@ -0,0 +1,41 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+class FLuaArray;
+
+namespace UnLua
+{
+    /**
+     * Zero-copy view of a numeric TArray. Items alias the memory of the array, so scripts can read/write and
+     * crunch the buffer without marshalling elements one by one.
+     *
+     * Arrays of float/double/int32/uint8 etc. are viewed element by element. Arrays of float structs (FVector etc.)
+     * are viewed as flattened components, or with a stride when a member name is given.
+     */
+    namespace ArrayView
+    {
+        /**
+         * Push a view of the array at the given index, the view keeps a reference to the array
+         *
+         * @param MemberName - member of the struct element to view, nullptr to view all components
+         * @return - false if the array can't be viewed
+         */
+        bool Push(lua_State* L, int32 ArrayIndex, FLuaArray* Array, const char* MemberName);
+    }
+}
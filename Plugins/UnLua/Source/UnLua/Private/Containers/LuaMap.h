@@ -20,27 +20,14 @@
 class FLuaMap
 {
 public:
+    /**
+     * Iteration state of 'pairs', it's placed in a plain userdata without metatable, so no heap allocation or finalizer is needed
+     */
     struct FLuaMapEnumerator
     {
-        FLuaMapEnumerator(FLuaMap* InLuaMap, const int32 InIndex): LuaMap(InLuaMap), Index(InIndex)
-        {
-        }
-
-        static int gc(lua_State* L)
-        {
-            if (FLuaMapEnumerator** Enumerator = (FLuaMapEnumerator**)lua_touserdata(L, 1))
-            {
-                (*Enumerator)->LuaMap = nullptr;
-
-                delete *Enumerator;
-            }
-
-            return 0;
-        }
-
         FLuaMap* LuaMap;
 
-        int32 Index = 0;
+        int32 Index;
     };
     
     enum FScriptMapFlag
@@ -153,6 +153,16 @@ public:
         }
     }
 
+    /**
+     * Get the max index of the set
+     *
+     * @return - the max index of the set
+     */
+    FORCEINLINE int32 GetMaxIndex() const
+    {
+        return Set->GetMaxIndex();
+    }
+
     /**
      * Get address of the i'th element
      *
@@ -0,0 +1,60 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaBytecodePak.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "UnLuaBase.h"
+
+namespace UnLua
+{
+    FBytecodePak::~FBytecodePak()
+    {
+        delete MappedRegion;
+        delete MappedFile;
+    }
+
+    TUniquePtr<FBytecodePak> FBytecodePak::Open(const FString& Path)
+    {
+        TUniquePtr<FBytecodePak> Pak(new FBytecodePak());
+        Pak->Path = Path;
+
+        const void* Memory = nullptr;
+        size_t Size = 0;
+        Pak->MappedFile = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path);
+        if (Pak->MappedFile)
+            Pak->MappedRegion = Pak->MappedFile->MapRegion(0, Pak->MappedFile->GetFileSize());
+
+        if (Pak->MappedRegion)
+        {
+            Memory = Pak->MappedRegion->GetMappedPtr();
+            Size = Pak->MappedRegion->GetMappedSize();
+        }
+        else
+        {
+            if (!FFileHelper::LoadFileToArray(Pak->Data, *Path, FILEREAD_Silent))
+                return nullptr;
+            Memory = Pak->Data.GetData();
+            Size = Pak->Data.Num();
+        }
+
+        if (!lpak_open(&Pak->Archive, Memory, Size))
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("Invalid lua bytecode pak : %s"), *Path);
+            return nullptr;
+        }
+        return Pak;
+    }
+}
@@ -0,0 +1,76 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+#ifdef __cplusplus
+#if !LUA_COMPILE_AS_CPP
+extern "C" {
+#endif
+#endif
+
+#include "lpak.h"
+
+#ifdef __cplusplus
+#if !LUA_COMPILE_AS_CPP
+}
+#endif
+#endif
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace UnLua
+{
+    /**
+     * A mounted archive of precompiled Lua chunks (see lpak.h). The file is memory-mapped when the platform
+     * supports it, chunks are loaded straight from the archive memory without any copy.
+     */
+    class FBytecodePak
+    {
+    public:
+        ~FBytecodePak();
+
+        /**
+         * Open an archive file
+         *
+         * @return - nullptr if the file can't be read or isn't a valid archive
+         */
+        static TUniquePtr<FBytecodePak> Open(const FString& Path);
+
+        /**
+         * Load the chunk of a module as a Lua function
+         *
+         * @return - the status of lua_load, or LPAK_NOTFOUND if the module isn't in this archive
+         */
+        FORCEINLINE int Load(lua_State* L, const char* ModuleName, const char* ChunkName) const
+        {
+            return lpak_load(L, &Archive, ModuleName, ChunkName);
+        }
+
+        FORCEINLINE const FString& GetPath() const { return Path; }
+
+    private:
+        FBytecodePak() = default;
+
+        FString Path;
+        lpak_Archive Archive;
+        IMappedFileHandle* MappedFile = nullptr;
+        IMappedFileRegion* MappedRegion = nullptr;
+        TArray<uint8> Data;     // fallback if the file can't be mapped
+    };
+}
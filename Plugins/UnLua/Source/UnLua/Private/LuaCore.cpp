@@ -22,6 +22,7 @@
 #include "Containers/LuaMap.h"
 #include "ReflectionUtils/FieldDesc.h"
 #include "ReflectionUtils/PropertyDesc.h"
+#include "ReflectionUtils/PropertyAccessor.h"
 
 #ifdef __cplusplus
 #if !LUA_COMPILE_AS_CPP
@@ -453,7 +454,8 @@ void* CacheScriptContainer(lua_State *L, void *Key, const FScriptContainerDesc &
 
     // return null if container is already cached, or create/cache/return a new ud
     void *Userdata = nullptr;
-    lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
+    auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, Env.GetContainerRegistry()->GetMapRef());
     lua_pushlightuserdata(L, Key);
     int32 Type = lua_rawget(L, -2);             
     if (Type == LUA_TNIL)
@@ -465,7 +467,7 @@ void* CacheScriptContainer(lua_State *L, void *Key, const FScriptContainerDesc &
         lua_pushlightuserdata(L, Key);
         lua_pushvalue(L, -2);
         lua_rawset(L, -4);                                  // cache it in 'ScriptContainerMap'
-        UnLua::FLuaEnv::FindEnv(L)->GetDanglingCheck()->CaptureContainer(L, Key);
+        Env.GetDanglingCheck()->CaptureContainer(L, Key);
     }
 #if UE_BUILD_DEBUG
     else
@@ -507,7 +509,7 @@ void RemoveCachedScriptContainer(lua_State *L, void *Key)
         return;
     }
 
-    lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
+    lua_rawgeti(L, LUA_REGISTRYINDEX, UnLua::FLuaEnv::FindEnvChecked(L).GetContainerRegistry()->GetMapRef());
     lua_pushlightuserdata(L, Key);
     int32 Type = lua_rawget(L, -2);
     if (Type != LUA_TNIL)
@@ -524,22 +526,34 @@ void RemoveCachedScriptContainer(lua_State *L, void *Key)
  */
 void PushObjectCore(lua_State *L, UObjectBaseUtility *Object)
 {
-    FString MetatableName = UnLua::LowLevel::GetMetatableName((UObject*)Object);
-    if (MetatableName.IsEmpty())
+    if (!Object)
     {
 		lua_pushnil(L);
 		return;
     }
-    
+
+    // enums use the metatable of their names, others use the metatable of the class (or the struct itself)
+    const UStruct* Type = Cast<UStruct>((UObject*)Object);
+    if (!Type && !Object->IsA<UEnum>())
+        Type = Object->GetClass();
+
 #if UNLUA_ENABLE_DEBUG != 0
-	UE_LOG(LogUnLua, Log, TEXT("%s : %p,%s,%s"), ANSI_TO_TCHAR(__FUNCTION__), Object,*Object->GetName(), *MetatableName);
+	UE_LOG(LogUnLua, Log, TEXT("%s : %p,%s,%s"), ANSI_TO_TCHAR(__FUNCTION__), Object,*Object->GetName(), *UnLua::LowLevel::GetMetatableName((UObject*)Object));
 #endif
 
     NewUserdataWithTwoLvPtrTag(L, sizeof(void*), Object);  // create a userdata and store the UObject address
-    bool bSuccess = TryToSetMetatable(L, TCHAR_TO_UTF8(*MetatableName), (UObject*)Object);
+    bool bSuccess;
+    if (Type)
+    {
+        bSuccess = UnLua::FLuaEnv::FindEnvChecked(L).GetClassRegistry()->TrySetMetatable(L, Type);
+    }
+    else
+    {
+        bSuccess = TryToSetMetatable(L, TCHAR_TO_UTF8(*UnLua::LowLevel::GetMetatableName((UObject*)Object)), (UObject*)Object);
+    }
 	if (!bSuccess)
 	{
-        UNLUA_LOGERROR(L, LogUnLua, Warning, TEXT("%s, Invalid metatable,Name %s, Object %s,%p!"), ANSI_TO_TCHAR(__FUNCTION__), *MetatableName, *Object->GetName(), Object);
+        UNLUA_LOGERROR(L, LogUnLua, Warning, TEXT("%s, Invalid metatable,Name %s, Object %s,%p!"), ANSI_TO_TCHAR(__FUNCTION__), *UnLua::LowLevel::GetMetatableName((UObject*)Object), *Object->GetName(), Object);
     }
 }
 
@@ -573,7 +587,7 @@ static void PushEnumElement(lua_State *L, FNumericProperty *Property, void *Valu
  */
 static void PushFNameElement(lua_State *L, FNameProperty *Property, void *Value)
 {
-    lua_pushstring(L, TCHAR_TO_UTF8(*Property->GetPropertyValue(Value).ToString()));
+    UnLua::FLuaEnv::FindEnvChecked(L).GetNameCache()->Push(L, Property->GetPropertyValue(Value));
 }
 
 /**
@@ -581,7 +595,7 @@ static void PushFNameElement(lua_State *L, FNameProperty *Property, void *Value)
  */
 static void PushFStringElement(lua_State *L, FStrProperty *Property, void *Value)
 {
-    lua_pushstring(L, TCHAR_TO_UTF8(*Property->GetPropertyValue(Value)));
+    UnLua::FLuaNameCache::PushString(L, Property->GetPropertyValue(Value));
 }
 
 /**
@@ -694,7 +708,7 @@ static void PushPropertyArray(lua_State *L, T *Property, void *Value, void(*Push
         return;
     }
 
-    lua_getfield(L, LUA_REGISTRYINDEX, "ArrayMap");         // get weak table 'ArrayMap'
+    lua_rawgeti(L, LUA_REGISTRYINDEX, UnLua::FLuaEnv::FindEnvChecked(L).GetArrayMapRef());     // get weak table 'ArrayMap'
     lua_pushlightuserdata(L, Value);
     int32 Type = lua_rawget(L, -2);
     if (Type != LUA_TTABLE)
@@ -819,7 +833,11 @@ bool GetObjectMapping(lua_State *L, UObjectBaseUtility *Object)
         return false;
     }
 
-    lua_getfield(L, LUA_REGISTRYINDEX, "UnLua_ObjectMap");
+    const auto Registry = UnLua::FLuaEnv::FindEnvChecked(L).GetObjectRegistry();
+    int32 Ref;
+    Registry->TryGetBoundRef((UObject*)Object, Ref); // create the table of lazily bound objects
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, Registry->GetObjectMapRef());
     lua_pushlightuserdata(L, Object);
     int32 Type = lua_rawget(L, -2);
     if (Type != LUA_TNIL)
@@ -904,6 +922,7 @@ bool PushFunction(lua_State *L, UObjectBaseUtility *Object, int32 FunctionRef)
 bool CallFunction(lua_State *L, int32 NumArgs, int32 NumResults)
 {
     int32 ErrorReporterIdx = lua_gettop(L) - NumArgs - 1;
+    const UnLua::FParamBufferArena::FScope ArenaScope(*UnLua::FLuaEnv::FindEnvChecked(L).GetParamBufferArena());
     int32 Code = lua_pcall(L, NumArgs, NumResults, -(NumArgs + 2));
     if (Code == LUA_OK)
     {
@@ -925,7 +944,7 @@ static void PushField(lua_State *L, TSharedPtr<FFieldDesc> Field)
     if (Field->IsProperty())
     {
         TSharedPtr<FPropertyDesc> Property = Field->AsProperty();
-        Env.GetObjectRegistry()->Push(L, Property);
+        UnLua::FPropertyAccessor::Push(L, Property);
     }
     else
     {
@@ -1396,6 +1415,24 @@ int32 Class_Index(lua_State *L)
     if (!Ptr)
         return 1;
 
+    const auto Accessor = UnLua::FPropertyAccessor::Get(L, -1);
+    if (Accessor && Accessor->IsValid())
+    {
+        void* Self = GetCppInstance(L, 1);
+        if (!Self)
+            return 1;
+
+        if (UnLua::LowLevel::IsReleasedPtr(Self))
+            return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to read property '%s' on released object"), *Accessor->Desc->GetName())));
+
+        if (!Accessor->CheckOwner(L, Self))
+            return 0;
+
+        Accessor->Read(L, Self);
+        lua_remove(L, -2);
+        return 1;
+    }
+
     auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(Ptr);
     if (!Property->IsValid())
         return 0;
@@ -1423,7 +1460,22 @@ int32 Class_NewIndex(lua_State *L)
     GetField(L);
 
     auto Ptr = lua_touserdata(L, -1);
-    if (Ptr)
+    const auto Accessor = UnLua::FPropertyAccessor::Get(L, -1);
+    if (Accessor && Accessor->IsValid())
+    {
+        void* Self = GetCppInstance(L, 1);
+        if (Self)
+        {
+            if (UnLua::LowLevel::IsReleasedPtr(Self))
+                return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to write property '%s' on released object"), *Accessor->Desc->GetName())));
+
+            if (!Accessor->CheckOwner(L, Self))
+                return 0;
+
+            Accessor->Write(L, Self, 3);
+        }
+    }
+    else if (Ptr)
     {
         auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(Ptr);
         if (Property->IsValid())
@@ -1464,8 +1516,8 @@ int32 Class_CallUFunction(lua_State *L)
 {
     //!!!Fix!!!
     //delete desc when is not valid
-    auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
-    auto Function = Env.GetObjectRegistry()->Get<FFunctionDesc>(L, lua_upvalueindex(1));
+    // the upvalue keeps the descriptor alive as long as this closure exists, no need to copy the shared pointer
+    FFunctionDesc* Function = UnLua::FObjectRegistry::GetRaw<FFunctionDesc>(L, lua_upvalueindex(1));
     if (!Function->IsValid())
     {
         UE_LOG(LogUnLua, Log, TEXT("%s: Invalid function descriptor!"), ANSI_TO_TCHAR(__FUNCTION__));
@@ -1482,7 +1534,7 @@ int32 Class_CallUFunction(lua_State *L)
 int32 Class_CallLatentFunction(lua_State *L)
 {
     auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
-    auto Function = Env.GetObjectRegistry()->Get<FFunctionDesc>(L, lua_upvalueindex(1));
+    FFunctionDesc* Function = UnLua::FObjectRegistry::GetRaw<FFunctionDesc>(L, lua_upvalueindex(1));
 	if (!Function->IsValid())
     {
         UE_LOG(LogUnLua, Log, TEXT("%s: Invalid function descriptor!"), ANSI_TO_TCHAR(__FUNCTION__));
@@ -1575,6 +1627,18 @@ int32 ScriptStruct_Index(lua_State *L)
     if (lua_type(L, -1) != LUA_TUSERDATA)
         return 1;
 
+    const auto Accessor = UnLua::FPropertyAccessor::Get(L, -1);
+    if (Accessor && Accessor->IsValid())
+    {
+        void* Self = GetCppInstanceFast(L, 1);
+        if (!Self)
+            return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to read property '%s' on released struct"), *Accessor->Desc->GetName())));
+
+        Accessor->Read(L, Self);
+        lua_remove(L, -2);
+        return 1;
+    }
+
     const auto Registry = UnLua::FLuaEnv::FindEnvChecked(L).GetObjectRegistry();
     const auto Property = Registry->Get<UnLua::ITypeOps>(L, -1);
     if (!Property.IsValid())
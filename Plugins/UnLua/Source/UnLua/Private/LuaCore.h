@@ -49,6 +49,7 @@ bool TryToSetMetatable(lua_State *L, const char *MetatableName, UObject* Object
  */
 void* NewUserdataWithTwoLvPtrTag(lua_State* L, int Size, void* Object);
 void* NewUserdataWithContainerTag(lua_State* L, int Size);
+void* NewUserdataWithPaddingTag(lua_State* L, int Size, uint8 Padding);
 void MarkUserdataTwoLvPtrTag(void* Userdata);
 void SetUserdataFlags(void* Userdata, uint8 Flags);
 UNLUA_API uint8 CalcUserdataPadding(int32 Alignment);
@@ -21,22 +21,16 @@ namespace UnLua
 {
     bool FDanglingCheck::Enabled;
 
-    FDanglingCheck::FGuard::FGuard(FDanglingCheck* Owner)
-        : Owner(Owner)
+    void FDanglingCheck::Release(int32 StructsStart, int32 ContainersStart)
     {
-        Owner->GuardCount++;
-    }
-
-    FDanglingCheck::FGuard::~FGuard()
-    {
-        Owner->GuardCount--;
+        const auto L = Env->GetMainState();
 
-        if (Owner->CapturedStructs.Num() > 0)
+        if (CapturedStructs.Num() > StructsStart)
         {
-            const auto L = Owner->Env->GetMainState();
-            lua_getfield(L, LUA_REGISTRYINDEX, "StructMap");
-            for (const auto& StructPtr : Owner->CapturedStructs)
+            lua_rawgeti(L, LUA_REGISTRYINDEX, Env->GetStructMapRef());
+            for (int32 i = StructsStart; i < CapturedStructs.Num(); ++i)
             {
+                void* StructPtr = CapturedStructs[i];
                 lua_pushlightuserdata(L, StructPtr);
                 lua_rawget(L, -2);
                 if (lua_isnil(L, -1))
@@ -58,16 +52,15 @@ namespace UnLua
                 lua_rawset(L, -3);
             }
             lua_pop(L, 1);
-            if (Owner->GuardCount == 0)
-                Owner->CapturedStructs.Empty();
+            CapturedStructs.SetNum(StructsStart, false);
         }
 
-        if (Owner->CapturedContainers.Num() > 0)
+        if (CapturedContainers.Num() > ContainersStart)
         {
-            const auto L = Owner->Env->GetMainState();
-            lua_getfield(L, LUA_REGISTRYINDEX, "ScriptContainerMap");
-            for (const auto& ContainerPtr : Owner->CapturedContainers)
+            lua_rawgeti(L, LUA_REGISTRYINDEX, Env->GetContainerRegistry()->GetMapRef());
+            for (int32 i = ContainersStart; i < CapturedContainers.Num(); ++i)
             {
+                void* ContainerPtr = CapturedContainers[i];
                 lua_pushlightuserdata(L, ContainerPtr);
                 lua_rawget(L, -2);
                 if (lua_isnil(L, -1))
@@ -88,8 +81,7 @@ namespace UnLua
                 lua_rawset(L, -3);
             }
             lua_pop(L, 1);
-            if (Owner->GuardCount == 0)
-                Owner->CapturedContainers.Empty();
+            CapturedContainers.SetNum(ContainersStart, false);
         }
     }
 
@@ -98,13 +90,6 @@ namespace UnLua
     {
     }
 
-    TUniquePtr<FDanglingCheck::FGuard> FDanglingCheck::MakeGuard()
-    {
-        if (!Enabled)
-            return TUniquePtr<FGuard>();
-        return MakeUnique<FGuard>(this);
-    }
-
     void FDanglingCheck::CaptureStruct(lua_State* L, void* Value)
     {
         if (!GuardCount)
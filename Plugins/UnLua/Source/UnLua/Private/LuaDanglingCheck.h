@@ -26,29 +26,53 @@ namespace UnLua
     public:
         static bool Enabled;
 
+        /**
+         * Stack guard of a Lua call. Values captured inside the guard are released when it ends, nothing
+         * happens when the check is disabled.
+         */
         class FGuard final
         {
         public:
-            explicit FGuard(FDanglingCheck* Owner);
+            explicit FGuard(FDanglingCheck* InOwner)
+                : Owner(Enabled ? InOwner : nullptr)
+            {
+                if (!Owner)
+                    return;
+                Owner->GuardCount++;
+                StructsStart = Owner->CapturedStructs.Num();
+                ContainersStart = Owner->CapturedContainers.Num();
+            }
 
-            ~FGuard();
+            ~FGuard()
+            {
+                if (!Owner)
+                    return;
+                Owner->GuardCount--;
+                if (Owner->CapturedStructs.Num() > StructsStart || Owner->CapturedContainers.Num() > ContainersStart)
+                    Owner->Release(StructsStart, ContainersStart);
+            }
+
+            FGuard(const FGuard&) = delete;
+            FGuard& operator=(const FGuard&) = delete;
 
         private:
             FDanglingCheck* Owner;
+            int32 StructsStart = 0;
+            int32 ContainersStart = 0;
         };
 
         explicit FDanglingCheck(FLuaEnv* Env);
 
-        TUniquePtr<FGuard> MakeGuard();
-
         void CaptureStruct(lua_State* L, void* Value);
 
         void CaptureContainer(lua_State* L, void* Value);
 
     private:
+        void Release(int32 StructsStart, int32 ContainersStart);
+
         FLuaEnv* Env;
         int32 GuardCount;
-        TSet<void*> CapturedStructs;
-        TSet<void*> CapturedContainers;
+        TArray<void*> CapturedStructs;      // captured values in the order of guards, released from the innermost
+        TArray<void*> CapturedContainers;
     };
 }
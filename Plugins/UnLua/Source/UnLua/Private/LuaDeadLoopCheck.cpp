@@ -13,103 +13,134 @@
 // See the License for the specific language governing permissions and limitations under the License.
 
 #include "LuaDeadLoopCheck.h"
-#include "HAL/RunnableThread.h"
+#include "LuaEnv.h"
 #include "UnLuaModule.h"
 
 namespace UnLua
 {
     int32 FDeadLoopCheck::Timeout = 0;
+    FDeadLoopCheck::FBudget FDeadLoopCheck::Budgets[(int32)EEntryPoint::Num];
+    bool FDeadLoopCheck::bAbortOnBudgetExceeded = false;
+    int32 FDeadLoopCheck::CheckInterval = 1000;
+
+    static const TCHAR* EntryPointNames[] = {TEXT("Other"), TEXT("Tick"), TEXT("Event"), TEXT("RPC")};
 
     FDeadLoopCheck::FDeadLoopCheck(FLuaEnv* Env)
-        : Env(Env)
+        : Env(Env), bEnabled(Timeout > 0), Instructions(0)
     {
-        Runner = new FRunner();
+        for (const auto& Budget : Budgets)
+            bEnabled |= Budget.IsSet();
+
+        if (bEnabled)
+            Env->GetHooks()->Add(LUA_MASKCOUNT, FMath::Max(CheckInterval, 1), OnCount, this);
     }
 
-    TUniquePtr<FDeadLoopCheck::FGuard> FDeadLoopCheck::MakeGuard()
+    FDeadLoopCheck::EEntryPoint FDeadLoopCheck::GetEntryPoint(const UFunction* Function)
     {
-        if (Timeout <= 0)
-            return TUniquePtr<FGuard>();
-        return MakeUnique<FGuard>(this);
+        static const FName NAME_ReceiveTick = TEXT("ReceiveTick");
+        static const FName NAME_Tick = TEXT("Tick");
+
+        if (!Function)
+            return EEntryPoint::Other;
+        if (Function->HasAnyFunctionFlags(FUNC_Net))
+            return EEntryPoint::RPC;
+        const FName Name = Function->GetFName();
+        if (Name == NAME_ReceiveTick || Name == NAME_Tick)
+            return EEntryPoint::Tick;
+        return EEntryPoint::Event;
     }
 
-    FDeadLoopCheck::FRunner::FRunner()
-        : bRunning(true),
-          GuardCounter(0),
-          TimeoutCounter(0),
-          TimeoutGuard(nullptr)
+    void FDeadLoopCheck::Enter(EEntryPoint Entry, const TCHAR* EntryName)
     {
-        Thread = FRunnableThread::Create(this, TEXT("LuaDeadLoopCheck"), 0, TPri_BelowNormal);
+        FFrame& Frame = Frames.AddDefaulted_GetRef();
+        Frame.EntryName = EntryName ? EntryName : EntryPointNames[(int32)Entry];
+        Frame.StartInstructions = Instructions;
+        Frame.StartTime = FPlatformTime::Seconds();
+        Frame.Entry = Entry;
+        Frame.bExceeded = false;
     }
 
-    uint32 FDeadLoopCheck::FRunner::Run()
+    void FDeadLoopCheck::Leave()
     {
-        while (bRunning)
+        FFrame& Frame = Frames.Last();
+        const FBudget& Budget = Budgets[(int32)Frame.Entry];
+        if (Frame.bExceeded || Budget.MaxMilliseconds > 0)
         {
-            FPlatformProcess::Sleep(1.0f);
-            if (GuardCounter.GetValue() == 0)
-                continue;
-
-            TimeoutCounter.Increment();
-            if (TimeoutCounter.GetValue() < Timeout)
-                continue;
-
-            const auto Guard = TimeoutGuard.load();
-            if (Guard)
+            // time spent in C++ is not seen by the hook, check it on leave
+            const int64 Used = (int64)(Instructions - Frame.StartInstructions);
+            const double Milliseconds = (FPlatformTime::Seconds() - Frame.StartTime) * 1000.0;
+            if (Frame.bExceeded)
+            {
+                FReport& Report = Reports.FindOrAdd(Frame.CallSite);
+                Report.PeakInstructions = FMath::Max(Report.PeakInstructions, Used);
+                Report.PeakMilliseconds = FMath::Max(Report.PeakMilliseconds, Milliseconds);
+            }
+            else if (Milliseconds > Budget.MaxMilliseconds)
             {
-                TimeoutGuard.store(nullptr);
-                Guard->SetTimeout();
+                Frame.CallSite = FString::Printf(TEXT("%s @ %s"), EntryPointNames[(int32)Frame.Entry], Frame.EntryName);
+                Record(Frame, Used, Milliseconds);
             }
         }
-        return 0;
+        Frames.Pop(false);
     }
 
-    void FDeadLoopCheck::FRunner::Stop()
+    void FDeadLoopCheck::Record(FFrame& Frame, int64 Used, double Milliseconds)
     {
-        bRunning = false;
-        TimeoutGuard.store(nullptr);
+        Frame.bExceeded = true;
+        FReport& Report = Reports.FindOrAdd(Frame.CallSite);
+        Report.Count++;
+        Report.PeakInstructions = FMath::Max(Report.PeakInstructions, Used);
+        Report.PeakMilliseconds = FMath::Max(Report.PeakMilliseconds, Milliseconds);
+
+        const FBudget& Budget = Budgets[(int32)Frame.Entry];
+        UE_LOG(LogUnLua, Warning, TEXT("lua script exceeded %s budget (%d instructions, %.2f ms) at %s: %lld instructions, %.2f ms, %d times"),
+               EntryPointNames[(int32)Frame.Entry], Budget.MaxInstructions, Budget.MaxMilliseconds, *Frame.CallSite, Used, Milliseconds, Report.Count);
     }
 
-    void FDeadLoopCheck::FRunner::Exit()
+    void FDeadLoopCheck::OnCount(lua_State* L, lua_Debug* ar, void* UserData)
     {
-        delete this;
-    }
+        const auto Check = (FDeadLoopCheck*)UserData;
+        Check->Instructions += Check->Env->GetHooks()->GetCount();
+        if (Check->Frames.Num() == 0)
+            return;
 
-    void FDeadLoopCheck::FRunner::GuardEnter(FGuard* Guard)
-    {
-        if (GuardCounter.Increment() > 1)
+        const double Now = FPlatformTime::Seconds();
+        if (Timeout > 0 && Now - Check->Frames[0].StartTime >= Timeout)
+        {
+            luaL_error(L, "lua script exec timeout");
             return;
-        TimeoutCounter.Set(0);
-        TimeoutGuard.store(Guard);
-    }
+        }
 
-    void FDeadLoopCheck::FRunner::GuardLeave()
-    {
-        GuardCounter.Decrement();
-    }
+        for (FFrame& Frame : Check->Frames)
+        {
+            const FBudget& Budget = Budgets[(int32)Frame.Entry];
+            if (Frame.bExceeded || !Budget.IsSet())
+                continue;
 
-    FDeadLoopCheck::FGuard::FGuard(FDeadLoopCheck* Owner)
-        : Owner(Owner)
-    {
-        Owner->Runner->GuardEnter(this);
-    }
+            const int64 Used = (int64)(Check->Instructions - Frame.StartInstructions);
+            const double Milliseconds = (Now - Frame.StartTime) * 1000.0;
+            if ((Budget.MaxInstructions <= 0 || Used <= Budget.MaxInstructions) && (Budget.MaxMilliseconds <= 0 || Milliseconds <= Budget.MaxMilliseconds))
+                continue;
 
-    FDeadLoopCheck::FGuard::~FGuard()
-    {
-        Owner->Runner->GuardLeave();
-    }
+            lua_getinfo(L, "Sl", ar);
+            Frame.CallSite = FString::Printf(TEXT("%s @ %s [%s:%d]"), EntryPointNames[(int32)Frame.Entry], Frame.EntryName, UTF8_TO_TCHAR(ar->short_src), ar->currentline);
+            Check->Record(Frame, Used, Milliseconds);
 
-    void FDeadLoopCheck::FGuard::SetTimeout()
-    {
-        const auto L = Owner->Env->GetMainState();
-        const auto Hook = lua_gethook(L);
-        if (Hook == nullptr)
-            lua_sethook(L, OnLuaLineEvent, LUA_MASKLINE, 0);
+            if (bAbortOnBudgetExceeded)
+            {
+                luaL_error(L, "lua script exceeded budget at %s", TCHAR_TO_UTF8(*Frame.CallSite));
+                return;
+            }
+        }
     }
 
-    void FDeadLoopCheck::FGuard::OnLuaLineEvent(lua_State* L, lua_Debug* ar)
+    void FDeadLoopCheck::DumpReports() const
     {
-        lua_sethook(L, nullptr, 0, 0);
-        luaL_error(L, "lua script exec timeout");
+        UE_LOG(LogUnLua, Log, TEXT("lua script budget report of %s, %d call sites:"), *Env->GetName(), Reports.Num());
+        for (const auto& Pair : Reports)
+        {
+            UE_LOG(LogUnLua, Log, TEXT("  %s: %d times, peak %lld instructions, %.2f ms"),
+                   *Pair.Key, Pair.Value.Count, Pair.Value.PeakInstructions, Pair.Value.PeakMilliseconds);
+        }
     }
 }
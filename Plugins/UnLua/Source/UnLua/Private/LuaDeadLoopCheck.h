@@ -15,63 +15,111 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "HAL/Runnable.h"
 #include "lua.hpp"
-#include <atomic>
 
 namespace UnLua
 {
     class FLuaEnv;
 
+    /**
+     * Watchdog of Lua calls from C++, based on the instruction count hook. It aborts calls running longer than
+     * 'Timeout' seconds, and reports (or aborts) calls exceeding the instruction/time budget of their entry point.
+     */
     class FDeadLoopCheck
     {
     public:
         static int32 Timeout; // in seconds
-        
-        class FGuard final
+
+        enum class EEntryPoint : uint8
         {
-        public:
-            explicit FGuard(FDeadLoopCheck* Owner);
+            Other,
+            Tick,
+            Event,
+            RPC,
+            Num
+        };
 
-            ~FGuard();
+        struct FBudget
+        {
+            int32 MaxInstructions = 0;      // 0 for unlimited
+            float MaxMilliseconds = 0;      // 0 for unlimited
 
-            void SetTimeout();
+            FORCEINLINE bool IsSet() const { return MaxInstructions > 0 || MaxMilliseconds > 0; }
+        };
 
-        private:
-            static void OnLuaLineEvent(lua_State* L, lua_Debug* ar);
+        static FBudget Budgets[(int32)EEntryPoint::Num];
 
-            FDeadLoopCheck* Owner;
+        static bool bAbortOnBudgetExceeded;
+
+        static int32 CheckInterval; // instructions between two checks
+
+        /** Breaches of a call site, keyed by '<entry point> @ <source:line>' */
+        struct FReport
+        {
+            int32 Count = 0;
+            int64 PeakInstructions = 0;
+            double PeakMilliseconds = 0;
         };
 
-        class FRunner final : public FRunnable
+        static EEntryPoint GetEntryPoint(const UFunction* Function);
+
+        /**
+         * Stack guard of a Lua call, nothing happens when the check is disabled
+         */
+        class FGuard final
         {
         public:
-            explicit FRunner();
+            explicit FGuard(FDeadLoopCheck* InOwner, EEntryPoint Entry = EEntryPoint::Other, const TCHAR* EntryName = nullptr)
+                : Owner(InOwner->bEnabled ? InOwner : nullptr)
+            {
+                if (Owner)
+                    Owner->Enter(Entry, EntryName);
+            }
+
+            ~FGuard()
+            {
+                if (Owner)
+                    Owner->Leave();
+            }
+
+            FGuard(const FGuard&) = delete;
+            FGuard& operator=(const FGuard&) = delete;
 
-            virtual uint32 Run() override;
+        private:
+            FDeadLoopCheck* Owner;
+        };
 
-            virtual void Stop() override;
+        explicit FDeadLoopCheck(FLuaEnv* Env);
 
-            virtual void Exit() override;
+        FORCEINLINE const TMap<FString, FReport>& GetReports() const { return Reports; }
 
-            void GuardEnter(FGuard* Guard);
+        void DumpReports() const;
 
-            void GuardLeave();
+        void ResetReports() { Reports.Empty(); }
 
-        private:
-            FThreadSafeBool bRunning;
-            FRunnableThread* Thread;
-            FThreadSafeCounter GuardCounter;
-            FThreadSafeCounter TimeoutCounter;
-            std::atomic<FGuard*> TimeoutGuard;
+    private:
+        struct FFrame
+        {
+            const TCHAR* EntryName;
+            uint64 StartInstructions;
+            double StartTime;
+            EEntryPoint Entry;
+            bool bExceeded;
+            FString CallSite;
         };
-        
-        explicit FDeadLoopCheck(FLuaEnv* Env);
 
-        TUniquePtr<FGuard> MakeGuard();
+        void Enter(EEntryPoint Entry, const TCHAR* EntryName);
+
+        void Leave();
+
+        static void OnCount(lua_State* L, lua_Debug* ar, void* UserData);
+
+        void Record(FFrame& Frame, int64 Used, double Milliseconds);
 
-    private:
-        FRunner* Runner;
         FLuaEnv* Env;
+        bool bEnabled;
+        uint64 Instructions;
+        TArray<FFrame> Frames;
+        TMap<FString, FReport> Reports;
     };
 }
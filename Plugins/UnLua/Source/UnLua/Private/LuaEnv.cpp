@@ -40,7 +40,7 @@ namespace UnLua
     FLuaEnv::FOnCreated FLuaEnv::OnDestroyed;
 
 #if ENABLE_UNREAL_INSIGHTS && CPUPROFILERTRACE_ENABLED
-    void Hook(lua_State* L, lua_Debug* ar)
+    void Hook(lua_State* L, lua_Debug* ar, void* UserData)
     {
         static TSet<FName> IgnoreNames{FName("Class"), FName("index"), FName("newindex")};
 
@@ -80,24 +80,32 @@ namespace UnLua
 
         RegisterDelegates();
 
+        // 小对象池只用于默认的分配器，作为ud传入
+        const auto Allocator = GetLuaAllocator();
+        if (Settings->bPoolSmallLuaObjects && Allocator == DefaultLuaAllocator)
+            SmallBlockPool = new FLuaSmallBlockPool();
+
 #if PLATFORM_WINDOWS
         // 防止类似AppleProResMedia插件忘了恢复Dll查找目录
         // https://github.com/Tencent/UnLua/issues/534
         const auto Dir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / TEXT("Binaries/Win64"));
         FPlatformProcess::PushDllDirectory(*Dir);
-        L = lua_newstate(GetLuaAllocator(), nullptr);
+        L = lua_newstate(Allocator, SmallBlockPool);
         FPlatformProcess::PopDllDirectory(*Dir);
 #else
-        L = lua_newstate(GetLuaAllocator(), nullptr);
+        L = lua_newstate(Allocator, SmallBlockPool);
 #endif
 
+        // 在主线程的额外空间里记录所属的Env，lua_newthread时会拷贝给协程
+        *(FLuaEnv**)lua_getextraspace(L) = this;
         AllEnvs.Add(L, this);
 
         luaL_openlibs(L);
 
         AddSearcher(LoadFromCustomLoader, 2);
-        AddSearcher(LoadFromFileSystem, 3);
-        AddSearcher(LoadFromBuiltinLibs, 4);
+        AddSearcher(LoadFromBytecodePak, 3);
+        AddSearcher(LoadFromFileSystem, 4);
+        AddSearcher(LoadFromBuiltinLibs, 5);
 
         UELib::Open(L);
 
@@ -112,17 +120,25 @@ namespace UnLua
         PropertyRegistry = new FPropertyRegistry(this);
         EnumRegistry = new FEnumRegistry(this);
         DanglingCheck = new FDanglingCheck(this);
+        Hooks = new FLuaHooks(L);
         DeadLoopCheck = new FDeadLoopCheck(this);
+        ParamBufferArena = new FParamBufferArena();
+        ModulePreloader = new FModulePreloader();
+        NameCache = new FLuaNameCache(L);
 
         AutoObjectReference.SetName("UnLua_AutoReference");
         ManualObjectReference.SetName("UnLua_ManualReference");
 
         lua_pushstring(L, "StructMap"); // create weak table 'StructMap'
         LowLevel::CreateWeakValueTable(L);
+        lua_pushvalue(L, -1);
+        StructMapRef = luaL_ref(L, LUA_REGISTRYINDEX);
         lua_rawset(L, LUA_REGISTRYINDEX);
 
         lua_pushstring(L, "ArrayMap"); // create weak table 'ArrayMap'
         LowLevel::CreateWeakValueTable(L);
+        lua_pushvalue(L, -1);
+        ArrayMapRef = luaL_ref(L, LUA_REGISTRYINDEX);
         lua_rawset(L, LUA_REGISTRYINDEX);
 
         if (FUnLuaDelegates::ConfigureLuaGC.IsBound())
@@ -159,14 +175,16 @@ namespace UnLua
 
         UnLuaLib::Open(L);
 
+        for (const auto& PakPath : Settings->BytecodePaks)
+            MountBytecodePak(FPaths::IsRelative(PakPath) ? FPaths::ProjectDir() / PakPath : PakPath);
+
+        PreloadModules(Settings->PreloadModules);
+
         OnCreated.Broadcast(*this);
         FUnLuaDelegates::OnLuaStateCreated.Broadcast(L);
 
 #if ENABLE_UNREAL_INSIGHTS && CPUPROFILERTRACE_ENABLED
-        if (FDeadLoopCheck::Timeout)
-            UE_LOG(LogUnLua, Warning, TEXT("Profiling will not working when DeadLoopCheck enabled."))
-        else
-            lua_sethook(L, Hook, LUA_MASKCALL | LUA_MASKRET, 0);
+        Hooks->Add(LUA_MASKCALL | LUA_MASKRET, 0, Hook);
 #endif
     }
 
@@ -175,16 +193,22 @@ namespace UnLua
         OnDestroyed.Broadcast(*this);
         lua_close(L);
         AllEnvs.Remove(L);
+        delete SmallBlockPool;
 
         delete ClassRegistry;
         delete ObjectRegistry;
         delete DelegateRegistry;
         delete FunctionRegistry;
+        FFunctionRegistry::InvalidateDispatchCache();
         delete ContainerRegistry;
         delete EnumRegistry;
         delete PropertyRegistry;
         delete DanglingCheck;
         delete DeadLoopCheck;
+        delete Hooks;
+        delete ParamBufferArena;
+        delete ModulePreloader;
+        delete NameCache;
 
         if (!IsEngineExitRequested() && Manager)
         {
@@ -215,11 +239,6 @@ namespace UnLua
         return AllEnvs.FindRef(MainThread);
     }
 
-    FLuaEnv& FLuaEnv::FindEnvChecked(const lua_State* L)
-    {
-        return *AllEnvs.FindChecked(G(L)->mainthread);
-    }
-
     void FLuaEnv::Start(const TMap<FString, UObject*>& Args)
     {
         const auto& Setting = *GetDefault<UUnLuaSettings>();
@@ -237,7 +256,7 @@ namespace UnLua
             return;
         }
 
-        const auto Guard = GetDeadLoopCheck()->MakeGuard();
+        const FDeadLoopCheck::FGuard Guard(GetDeadLoopCheck());
         lua_pushcfunction(L, ReportLuaCallError);
         lua_getglobal(L, "require");
         lua_pushstring(L, TCHAR_TO_UTF8(*StartupModuleName));
@@ -264,12 +283,14 @@ namespace UnLua
     void FLuaEnv::NotifyUObjectDeleted(const UObjectBase* ObjectBase, int32 Index)
     {
         UObject* Object = (UObject*)ObjectBase;
-        PropertyRegistry->NotifyUObjectDeleted(Object);
-        FunctionRegistry->NotifyUObjectDeleted(Object);
-        if (Manager)
-            Manager->NotifyUObjectDeleted(Object);
+
+        // lua may still hold this object, release it immediately
         ObjectRegistry->NotifyUObjectDeleted(Object);
 
+        // the others are only keyed by classes/functions/fields, clean them up in batch. the class of the object may
+        // be freed in the same purge, so don't touch it and let each registry filter by its own map
+        DeletedObjects.Add(Object);
+
         if (CandidateInputComponents.Num() <= 0)
             return;
 
@@ -278,6 +299,21 @@ namespace UnLua
             FWorldDelegates::OnWorldTickStart.Remove(OnWorldTickStartHandle);
     }
 
+    void FLuaEnv::OnPostGarbageCollect()
+    {
+        FlushDeletedObjects();
+    }
+
+    void FLuaEnv::ProcessDeletedObjects()
+    {
+        ClassRegistry->NotifyUObjectsDeleted(DeletedObjects);
+        PropertyRegistry->NotifyUObjectsDeleted(DeletedObjects);
+        FunctionRegistry->NotifyUObjectsDeleted(DeletedObjects);
+        if (Manager)
+            Manager->NotifyUObjectsDeleted(DeletedObjects);
+        DeletedObjects.Reset();
+    }
+
     void FLuaEnv::OnUObjectArrayShutdown()
     {
         GUObjectArray.RemoveUObjectDeleteListener(this);
@@ -332,6 +368,8 @@ namespace UnLua
 
     bool FLuaEnv::TryBind(UObject* Object)
     {
+        FlushDeletedObjects();
+
         const auto Class = Object->IsA<UClass>() ? static_cast<UClass*>(Object) : Object->GetClass();
         if (Class->HasAnyClassFlags(CLASS_NewerVersionExists))
         {
@@ -387,8 +425,9 @@ namespace UnLua
     {
         const FTCHARToUTF8 ChunkUTF8(*Chunk);
         const FTCHARToUTF8 ChunkNameUTF8(*ChunkName);
-        const auto Guard = GetDeadLoopCheck()->MakeGuard();
-        const auto DanglingGuard = GetDanglingCheck()->MakeGuard();
+        const FDeadLoopCheck::FGuard Guard(GetDeadLoopCheck());
+        const FDanglingCheck::FGuard DanglingGuard(GetDanglingCheck());
+        const FParamBufferArena::FScope ArenaScope(*ParamBufferArena);
         lua_pushcfunction(L, ReportLuaCallError);
         const auto MsgHandlerIdx = lua_gettop(L);
         if (!LoadBuffer(L, ChunkUTF8.Get(), ChunkUTF8.Length(), ChunkNameUTF8.Get()))
@@ -460,6 +499,7 @@ namespace UnLua
             return;
 
         lua_State* Thread = *ThreadPtr;
+        const FParamBufferArena::FScope ArenaScope(*ParamBufferArena);
 #if 504 == LUA_VERSION_NUM
         int NResults = 0;
         int32 Status = lua_resume(Thread, L, 0, &NResults);
@@ -520,6 +560,30 @@ namespace UnLua
         return DefaultLuaAllocator;
     }
 
+    void FLuaEnv::PreloadModules(const TArray<FString>& ModuleNames)
+    {
+        if (ModuleNames.Num() == 0)
+            return;
+
+        const auto PackagePath = UnLuaLib::GetPackagePath(L);
+        if (PackagePath.IsEmpty())
+            return;
+
+        ModulePreloader->Preload(PackagePath, ModuleNames);
+    }
+
+    bool FLuaEnv::MountBytecodePak(const FString& Path)
+    {
+        auto Pak = FBytecodePak::Open(Path);
+        if (!Pak)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("Failed to mount lua bytecode pak : %s"), *Path);
+            return false;
+        }
+        BytecodePaks.Add(MoveTemp(Pak));
+        return true;
+    }
+
     void FLuaEnv::AddLoader(const FLuaFileLoader Loader)
     {
         CustomLoaders.Add(Loader);
@@ -591,50 +655,51 @@ namespace UnLua
         return 1;
     }
 
+    int FLuaEnv::LoadFromBytecodePak(lua_State* L)
+    {
+        const auto& Env = *(FLuaEnv*)lua_touserdata(L, lua_upvalueindex(1));
+        if (Env.BytecodePaks.Num() == 0)
+            return 0;
+
+        const char* ModuleName = lua_tostring(L, 1);
+
+        // 下载目录下的单文件用于热更，优先于字节码包，交给文件系统加载
+        const auto PackagePath = UnLuaLib::GetPackagePath(L);
+        if (!PackagePath.IsEmpty() && FModulePreloader::IsDownloaded(PackagePath, UTF8_TO_TCHAR(ModuleName)))
+            return 0;
+
+        for (int32 i = Env.BytecodePaks.Num() - 1; i >= 0; --i)
+        {
+            // 后挂载的包优先，用于覆盖更新
+            const int Code = Env.BytecodePaks[i]->Load(L, ModuleName, ModuleName);
+            if (Code == LPAK_NOTFOUND)
+                continue;
+            if (Code == LUA_OK)
+                return 1;
+            return luaL_error(L, "error loading module '%s' from bytecode pak '%s':\n\t%s", ModuleName,
+                              TCHAR_TO_UTF8(*Env.BytecodePaks[i]->GetPath()), lua_tostring(L, -1));
+        }
+        return 0;
+    }
+
     int FLuaEnv::LoadFromFileSystem(lua_State* L)
     {
-        FString FileName(UTF8_TO_TCHAR(lua_tostring(L, 1)));
-        FileName.ReplaceInline(TEXT("."), TEXT("/"));
+        const FString ModuleName(UTF8_TO_TCHAR(lua_tostring(L, 1)));
 
         auto& Env = *(FLuaEnv*)lua_touserdata(L, lua_upvalueindex(1));
         TArray<uint8> Data;
         FString FullPath;
 
-        auto LoadIt = [&]
-        {
-            if (Env.LoadString(L, Data, TCHAR_TO_UTF8(*FullPath)))
-                return 1;
-            return luaL_error(L, "file loading from file system error");
-        };
-
         const auto PackagePath = UnLuaLib::GetPackagePath(L);
         if (PackagePath.IsEmpty())
             return 0;
 
-        TArray<FString> Patterns;
-        if (PackagePath.ParseIntoArray(Patterns, TEXT(";"), false) == 0)
+        if (!Env.ModulePreloader->Load(PackagePath, ModuleName, Data, FullPath))
             return 0;
 
-        // 优先加载下载目录下的单文件
-        for (auto& Pattern : Patterns)
-        {
-            Pattern.ReplaceInline(TEXT("?"), *FileName);
-            const auto PathWithPersistentDir = FPaths::Combine(FPaths::ProjectPersistentDownloadDir(), Pattern);
-            FullPath = FPaths::ConvertRelativePathToFull(PathWithPersistentDir);
-            if (FFileHelper::LoadFileToArray(Data, *FullPath, FILEREAD_Silent))
-                return LoadIt();
-        }
-
-        // 其次是打包目录下的文件
-        for (auto& Pattern : Patterns)
-        {
-            const auto PathWithProjectDir = FPaths::Combine(FPaths::ProjectDir(), Pattern);
-            FullPath = FPaths::ConvertRelativePathToFull(PathWithProjectDir);
-            if (FFileHelper::LoadFileToArray(Data, *FullPath, FILEREAD_Silent))
-                return LoadIt();
-        }
-
-        return 0;
+        if (Env.LoadString(L, Data, TCHAR_TO_UTF8(*FullPath)))
+            return 1;
+        return luaL_error(L, "file loading from file system error");
     }
 
     void FLuaEnv::AddSearcher(lua_CFunction Searcher, int Index) const
@@ -717,6 +782,7 @@ namespace UnLua
     FORCEINLINE void FLuaEnv::RegisterDelegates()
     {
         OnAsyncLoadingFlushUpdateHandle = FCoreDelegates::OnAsyncLoadingFlushUpdate.AddRaw(this, &FLuaEnv::OnAsyncLoadingFlushUpdate);
+        PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FLuaEnv::OnPostGarbageCollect);
         GUObjectArray.AddUObjectDeleteListener(this);
         bObjectArrayListenerRegistered = true;
     }
@@ -724,6 +790,7 @@ namespace UnLua
     FORCEINLINE void FLuaEnv::UnRegisterDelegates()
     {
         FCoreDelegates::OnAsyncLoadingFlushUpdate.Remove(OnAsyncLoadingFlushUpdateHandle);
+        FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
         if (!bObjectArrayListenerRegistered)
             return;
         GUObjectArray.RemoveUObjectDeleteListener(this);
@@ -732,6 +799,9 @@ namespace UnLua
 
     void* FLuaEnv::DefaultLuaAllocator(void* ud, void* ptr, size_t osize, size_t nsize)
     {
+        if (ud)
+            return ((FLuaSmallBlockPool*)ud)->Realloc(ptr, osize, nsize);
+
         if (nsize == 0)
         {
             UNLUA_STAT_MEMORY_FREE(ptr, Lua);
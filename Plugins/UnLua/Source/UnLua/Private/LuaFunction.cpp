@@ -44,13 +44,7 @@ static UClass* MakeOrphanedClass(const UClass* Class)
 DEFINE_FUNCTION(ULuaFunction::execCallLua)
 {
     const auto LuaFunction = Cast<ULuaFunction>(Stack.CurrentNativeFunction);
-    const auto Env = IUnLuaModule::Get().GetEnv(Context);
-    if (!Env)
-    {
-        // PIE 结束时可能已经没有Lua环境了
-        return;
-    }
-    Env->GetFunctionRegistry()->Invoke(LuaFunction, Context, Stack, RESULT_PARAM);
+    UnLua::FFunctionRegistry::Dispatch(LuaFunction, Context, Stack, RESULT_PARAM);
 }
 
 bool ULuaFunction::IsOverridable(const UFunction* Function)
@@ -0,0 +1,68 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaHooks.h"
+#include "LuaEnv.h"
+
+namespace UnLua
+{
+    FLuaHooks::FLuaHooks(lua_State* L)
+        : L(L), NextHandle(1), Count(0)
+    {
+    }
+
+    int32 FLuaHooks::Add(int32 Mask, int32 InCount, FHookFunc Func, void* UserData)
+    {
+        check(Func);
+        const int32 Handle = NextHandle++;
+        Entries.Add({Handle, Mask, (Mask & LUA_MASKCOUNT) ? FMath::Max(InCount, 1) : 0, Func, UserData});
+        Install();
+        return Handle;
+    }
+
+    void FLuaHooks::Remove(int32 Handle)
+    {
+        Entries.RemoveAll([Handle](const FEntry& Entry) { return Entry.Handle == Handle; });
+        Install();
+    }
+
+    void FLuaHooks::Install()
+    {
+        int32 Mask = 0;
+        Count = 0;
+        for (const auto& Entry : Entries)
+        {
+            Mask |= Entry.Mask;
+            if (Entry.Count > 0)
+                Count = Count > 0 ? FMath::Min(Count, Entry.Count) : Entry.Count;
+        }
+
+        if (Mask == 0)
+            lua_sethook(L, nullptr, 0, 0);
+        else
+            lua_sethook(L, Dispatch, Mask, Count);
+    }
+
+    void FLuaHooks::Dispatch(lua_State* L, lua_Debug* ar)
+    {
+        const auto Hooks = FLuaEnv::FindEnvChecked(L).GetHooks();
+        const int32 Mask = ar->event == LUA_HOOKTAILCALL ? LUA_MASKCALL : 1 << ar->event;
+        for (int32 i = 0; i < Hooks->Entries.Num(); ++i)
+        {
+            const FEntry Entry = Hooks->Entries[i];     // hooks may be removed inside
+            if (Entry.Mask & Mask)
+                Entry.Func(L, ar, Entry.UserData);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+namespace UnLua
+{
+    /**
+     * Multiplexer of lua_sethook, so profilers and script checks can hook the same lua_State. Coroutines
+     * created after installing inherit the hook of the main thread.
+     */
+    class FLuaHooks
+    {
+    public:
+        typedef void (*FHookFunc)(lua_State* L, lua_Debug* ar, void* UserData);
+
+        explicit FLuaHooks(lua_State* L);
+
+        /**
+         * Add a hook function for the events in the mask. Count hooks share the smallest count requested.
+         *
+         * @return - handle to remove the hook
+         */
+        int32 Add(int32 Mask, int32 Count, FHookFunc Func, void* UserData = nullptr);
+
+        void Remove(int32 Handle);
+
+        /**
+         * Get the number of instructions between two count events
+         */
+        FORCEINLINE int32 GetCount() const { return Count; }
+
+    private:
+        static void Dispatch(lua_State* L, lua_Debug* ar);
+
+        void Install();
+
+        struct FEntry
+        {
+            int32 Handle;
+            int32 Mask;
+            int32 Count;
+            FHookFunc Func;
+            void* UserData;
+        };
+
+        lua_State* L;
+        TArray<FEntry> Entries;
+        int32 NextHandle;
+        int32 Count;
+    };
+}
@@ -0,0 +1,206 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaModulePreloader.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "lua.hpp"
+
+namespace UnLua
+{
+    static void* PreloadAllocator(void* ud, void* ptr, size_t osize, size_t nsize)
+    {
+        if (nsize == 0)
+        {
+            FMemory::Free(ptr);
+            return nullptr;
+        }
+        return FMemory::Realloc(ptr, nsize);
+    }
+
+    static int WriteBytecode(lua_State* L, const void* Data, size_t Size, void* UserData)
+    {
+        static_cast<TArray<uint8>*>(UserData)->Append(static_cast<const uint8*>(Data), Size);
+        return 0;
+    }
+
+    FModulePreloader::~FModulePreloader()
+    {
+        for (auto& Pair : Modules)
+            Pair.Value.Wait();
+    }
+
+    void FModulePreloader::Preload(const FString& PackagePath, const TArray<FString>& ModuleNames)
+    {
+        if (PreloadedPackagePath != PackagePath)
+        {
+            // modules preloaded with another package path can't be used anymore
+            for (auto& Pair : Modules)
+                Pair.Value.Wait();
+            Modules.Empty();
+            PreloadedPackagePath = PackagePath;
+        }
+
+        for (const auto& ModuleName : ModuleNames)
+        {
+            if (ModuleName.IsEmpty() || Modules.Contains(ModuleName))
+                continue;
+
+            Modules.Add(ModuleName, Async(EAsyncExecution::ThreadPool, [PackagePath, ModuleName]
+            {
+                return Compile(PackagePath, ModuleName);
+            }));
+        }
+    }
+
+    bool FModulePreloader::Consume(const FString& PackagePath, const FString& ModuleName, TArray<uint8>& OutData, FString& OutFullPath)
+    {
+        if (Modules.Num() == 0)
+            return false;
+
+        TFuture<FPreloadedModule> Future;
+        if (!Modules.RemoveAndCopyValue(ModuleName, Future) || PackagePath != PreloadedPackagePath)
+            return false;
+
+        FPreloadedModule Module = Future.Get();
+        if (Module.Bytecode.Num() == 0)
+            return false;
+
+        OutData = MoveTemp(Module.Bytecode);
+        OutFullPath = MoveTemp(Module.FullPath);
+        return true;
+    }
+
+    bool FModulePreloader::Load(const FString& PackagePath, const FString& ModuleName, TArray<uint8>& OutData, FString& OutFullPath)
+    {
+        if (ResolvedPackagePath != PackagePath)
+        {
+            ResolvedPaths.Reset();
+            ResolvedPackagePath = PackagePath;
+        }
+
+        if (Consume(PackagePath, ModuleName, OutData, OutFullPath))
+        {
+            ResolvedPaths.Add(ModuleName, OutFullPath);
+            return true;
+        }
+
+        if (const auto ResolvedPath = ResolvedPaths.Find(ModuleName))
+        {
+            // files may be downloaded at any time, and they override the ones in the project directory
+            const FString PersistentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectPersistentDownloadDir());
+            if (!ResolvedPath->StartsWith(PersistentDir)
+                && LoadModuleFileInDir(FPaths::ProjectPersistentDownloadDir(), PackagePath, ModuleName, OutData, OutFullPath))
+            {
+                *ResolvedPath = OutFullPath;
+                return true;
+            }
+
+            OutFullPath = *ResolvedPath;
+            if (FFileHelper::LoadFileToArray(OutData, *OutFullPath, FILEREAD_Silent))
+                return true;
+        }
+
+        // missing modules are not remembered, they may be created in editor or downloaded later
+        if (!LoadModuleFile(PackagePath, ModuleName, OutData, OutFullPath))
+            return false;
+
+        ResolvedPaths.Add(ModuleName, OutFullPath);
+        return true;
+    }
+
+    void FModulePreloader::ClearResolvedPaths()
+    {
+        ResolvedPaths.Empty();
+    }
+
+    bool FModulePreloader::LoadModuleFile(const FString& PackagePath, const FString& ModuleName, TArray<uint8>& OutData, FString& OutFullPath)
+    {
+        // 优先加载下载目录下的单文件，其次是打包目录下的文件
+        return LoadModuleFileInDir(FPaths::ProjectPersistentDownloadDir(), PackagePath, ModuleName, OutData, OutFullPath)
+            || LoadModuleFileInDir(FPaths::ProjectDir(), PackagePath, ModuleName, OutData, OutFullPath);
+    }
+
+    bool FModulePreloader::IsDownloaded(const FString& PackagePath, const FString& ModuleName)
+    {
+        const FString FileName = ModuleName.Replace(TEXT("."), TEXT("/"));
+
+        TArray<FString> Patterns;
+        PackagePath.ParseIntoArray(Patterns, TEXT(";"), false);
+        for (auto& Pattern : Patterns)
+        {
+            Pattern.ReplaceInline(TEXT("?"), *FileName);
+            if (FPaths::FileExists(FPaths::Combine(FPaths::ProjectPersistentDownloadDir(), Pattern)))
+                return true;
+        }
+
+        return false;
+    }
+
+    bool FModulePreloader::LoadModuleFileInDir(const FString& Dir, const FString& PackagePath, const FString& ModuleName, TArray<uint8>& OutData, FString& OutFullPath)
+    {
+        const FString FileName = ModuleName.Replace(TEXT("."), TEXT("/"));
+
+        TArray<FString> Patterns;
+        if (PackagePath.ParseIntoArray(Patterns, TEXT(";"), false) == 0)
+            return false;
+
+        for (auto& Pattern : Patterns)
+        {
+            Pattern.ReplaceInline(TEXT("?"), *FileName);
+            OutFullPath = FPaths::ConvertRelativePathToFull(FPaths::Combine(Dir, Pattern));
+            if (FFileHelper::LoadFileToArray(OutData, *OutFullPath, FILEREAD_Silent))
+                return true;
+        }
+
+        return false;
+    }
+
+    FModulePreloader::FPreloadedModule FModulePreloader::Compile(const FString& PackagePath, const FString& ModuleName)
+    {
+        FPreloadedModule Module;
+        TArray<uint8> Source;
+        if (!LoadModuleFile(PackagePath, ModuleName, Source, Module.FullPath))
+            return Module;
+
+        const char* Buffer = (const char*)Source.GetData();
+        size_t Size = Source.Num();
+        if (Size > 0 && Buffer[0] == LUA_SIGNATURE[0])
+        {
+            // already precompiled
+            Module.Bytecode = MoveTemp(Source);
+            return Module;
+        }
+
+#if UNLUA_LEGACY_ALLOW_BOM
+        if (Size > 3 && Buffer[0] == static_cast<char>(0xEF) && Buffer[1] == static_cast<char>(0xBB) && Buffer[2] == static_cast<char>(0xBF))
+        {
+            Buffer += 3;
+            Size -= 3;
+        }
+#endif
+
+        // compile in a throwaway state, syntax errors are left to the game thread to report
+        lua_State* L = lua_newstate(PreloadAllocator, nullptr);
+        if (!L)
+            return Module;
+
+        if (luaL_loadbufferx(L, Buffer, Size, TCHAR_TO_UTF8(*Module.FullPath), "t") == LUA_OK)
+            lua_dump(L, WriteBytecode, &Module.Bytecode, 0);
+
+        lua_close(L);
+        return Module;
+    }
+}
@@ -0,0 +1,84 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+namespace UnLua
+{
+    /**
+     * Read and precompile Lua modules to bytecode on worker threads, so that 'require' on the game thread only
+     * loads ready-made bytecode instead of reading and parsing the source file. Files resolved on the game thread
+     * are cached by module name, so searching 'package.path' happens once per found module. Only the persistent
+     * download directory is searched again, as files downloaded at runtime override the cached ones.
+     */
+    class FModulePreloader
+    {
+    public:
+        ~FModulePreloader();
+
+        /**
+         * Start preloading modules in background, modules are resolved by the given package path
+         */
+        void Preload(const FString& PackagePath, const TArray<FString>& ModuleNames);
+
+        /**
+         * Take the precompiled chunk of a module, waiting for it if it's still in progress
+         *
+         * @return - false if the module isn't preloaded with the same package path or failed to compile
+         */
+        bool Consume(const FString& PackagePath, const FString& ModuleName, TArray<uint8>& OutData, FString& OutFullPath);
+
+        /**
+         * Load a module for 'require', using the preloaded chunk or the cached file path if possible
+         *
+         * @return - false if the module can't be found in file system
+         */
+        bool Load(const FString& PackagePath, const FString& ModuleName, TArray<uint8>& OutData, FString& OutFullPath);
+
+        /**
+         * Forget all resolved file paths, modules will be searched in 'package.path' again
+         */
+        void ClearResolvedPaths();
+
+        /**
+         * Find and read the file of a Lua module. Files in the persistent download directory are preferred to
+         * the ones in the project directory.
+         */
+        static bool LoadModuleFile(const FString& PackagePath, const FString& ModuleName, TArray<uint8>& OutData, FString& OutFullPath);
+
+        /**
+         * Check whether a Lua module has a file in the persistent download directory, which overrides every other source
+         */
+        static bool IsDownloaded(const FString& PackagePath, const FString& ModuleName);
+
+    private:
+        static bool LoadModuleFileInDir(const FString& Dir, const FString& PackagePath, const FString& ModuleName, TArray<uint8>& OutData, FString& OutFullPath);
+
+        struct FPreloadedModule
+        {
+            FString FullPath;
+            TArray<uint8> Bytecode;
+        };
+
+        static FPreloadedModule Compile(const FString& PackagePath, const FString& ModuleName);
+
+        FString PreloadedPackagePath;
+        TMap<FString, TFuture<FPreloadedModule>> Modules;
+        FString ResolvedPackagePath;
+        TMap<FString, FString> ResolvedPaths;
+    };
+}
@@ -0,0 +1,92 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaNameCache.h"
+#include "Misc/StringBuilder.h"
+
+namespace UnLua
+{
+    // strings longer than LUAI_MAXSHORTLEN are not interned by Lua
+    static constexpr size_t MaxInternedLength = 40;
+
+    // strings converted from lua are anchored until the cache is full, then all of them are dropped at once
+    static constexpr int32 MaxCachedStrings = 4096;
+
+    FLuaNameCache::FLuaNameCache(lua_State* L)
+    {
+        lua_newtable(L);
+        NameToStringRef = luaL_ref(L, LUA_REGISTRYINDEX);
+        lua_newtable(L);
+        StringAnchorsRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+
+    void FLuaNameCache::Push(lua_State* L, const FName& Name)
+    {
+        const lua_Integer Key = GetNameKey(Name);
+        lua_rawgeti(L, LUA_REGISTRYINDEX, NameToStringRef);
+        if (lua_rawgeti(L, -1, Key) == LUA_TSTRING)
+        {
+            lua_remove(L, -2);
+            return;
+        }
+        lua_pop(L, 1);
+
+        TStringBuilder<NAME_SIZE> Builder;
+        Name.AppendString(Builder);
+        const FTCHARToUTF8 Utf8(Builder.ToString(), Builder.Len());
+        lua_pushlstring(L, Utf8.Get(), Utf8.Length());
+        lua_pushvalue(L, -1);
+        lua_rawseti(L, -3, Key);
+        lua_remove(L, -2);
+    }
+
+    FName FLuaNameCache::Get(lua_State* L, int32 Index)
+    {
+        size_t Len = 0;
+        const char* Str = lua_tolstring(L, Index, &Len);
+        if (!Str)
+            return NAME_None;
+
+        if (Len > MaxInternedLength)
+        {
+            const FUTF8ToTCHAR Converted(Str, Len);
+            return FName(Converted.Length(), Converted.Get());
+        }
+
+        if (const FName* Found = StringToName.Find(Str))
+            return *Found;
+
+        const FUTF8ToTCHAR Converted(Str, Len);
+        const FName Name(Converted.Length(), Converted.Get());
+
+        if (StringToName.Num() >= MaxCachedStrings)
+        {
+            // the addresses must be forgotten together with the anchors, as the strings may be collected after this
+            StringToName.Reset();
+            lua_newtable(L);
+            lua_rawseti(L, LUA_REGISTRYINDEX, StringAnchorsRef);
+        }
+
+        // keep the string alive, so its address will not be reused by another string
+        Index = lua_absindex(L, Index);
+        lua_rawgeti(L, LUA_REGISTRYINDEX, StringAnchorsRef);
+        lua_pushvalue(L, Index);
+        lua_pushboolean(L, true);
+        lua_rawset(L, -3);
+        lua_pop(L, 1);
+
+        StringToName.Add(Str, Name);
+        return Name;
+    }
+}
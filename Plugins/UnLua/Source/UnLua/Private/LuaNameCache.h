@@ -0,0 +1,77 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "lua.hpp"
+
+namespace UnLua
+{
+    /**
+     * Bidirectional cache between FName and interned Lua strings, one per env. Lua strings of names are kept
+     * in a registry table keyed by the name index and number, while names of short Lua strings (which are
+     * interned by Lua) are keyed by the address of the string, which is anchored in the registry too. The anchored
+     * strings are bounded, the whole string cache is dropped when it is full.
+     */
+    class FLuaNameCache
+    {
+    public:
+        explicit FLuaNameCache(lua_State* L);
+
+        /**
+         * Push the Lua string of the name
+         */
+        void Push(lua_State* L, const FName& Name);
+
+        /**
+         * Get the name of the string (or number) at the given index, NAME_None for other types
+         */
+        FName Get(lua_State* L, int32 Index);
+
+        /**
+         * Push a FString without converting to a temporary FString/std::string
+         */
+        static FORCEINLINE void PushString(lua_State* L, const FString& Value)
+        {
+            const FTCHARToUTF8 Utf8(*Value, Value.Len());
+            lua_pushlstring(L, Utf8.Get(), Utf8.Length());
+        }
+
+        /**
+         * Assign the string at the given index to the FString, reusing its buffer
+         */
+        static FORCEINLINE void GetString(lua_State* L, int32 Index, FString& OutValue)
+        {
+            size_t Len = 0;
+            const char* Str = lua_tolstring(L, Index, &Len);
+            OutValue.Reset();
+            if (!Str || Len == 0)
+                return;
+            const FUTF8ToTCHAR Converted(Str, Len);
+            OutValue.AppendChars(Converted.Get(), Converted.Length());
+        }
+
+    private:
+        static FORCEINLINE lua_Integer GetNameKey(const FName& Name)
+        {
+            // display index keeps the case of the name when WITH_CASE_PRESERVING_NAME is on
+            return (lua_Integer)(((uint64)Name.GetDisplayIndex().ToUnstableInt() << 32) | (uint32)Name.GetNumber());
+        }
+
+        TMap<const char*, FName> StringToName;
+        int32 NameToStringRef;
+        int32 StringAnchorsRef;
+    };
+}
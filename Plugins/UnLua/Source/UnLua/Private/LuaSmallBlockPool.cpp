@@ -0,0 +1,112 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaSmallBlockPool.h"
+#include "UnLuaPrivate.h"
+
+namespace UnLua
+{
+    FLuaSmallBlockPool::FLuaSmallBlockPool()
+    {
+        FMemory::Memzero(FreeLists, sizeof(FreeLists));
+    }
+
+    FLuaSmallBlockPool::~FLuaSmallBlockPool()
+    {
+        for (void* Chunk : Chunks)
+        {
+            UNLUA_STAT_MEMORY_FREE(Chunk, Lua);
+            FMemory::Free(Chunk);
+        }
+    }
+
+    void* FLuaSmallBlockPool::Realloc(void* Ptr, SIZE_T OldSize, SIZE_T NewSize)
+    {
+        // 'OldSize' is the kind of the new object when 'Ptr' is null
+        if (!Ptr)
+            OldSize = 0;
+
+        const bool bOldPooled = Ptr && IsPooled(OldSize);
+        if (NewSize == 0)
+        {
+            if (bOldPooled)
+            {
+                Free(Ptr, OldSize);
+            }
+            else
+            {
+                UNLUA_STAT_MEMORY_FREE(Ptr, Lua);
+                FMemory::Free(Ptr);
+            }
+            return nullptr;
+        }
+
+        if (IsPooled(NewSize))
+        {
+            if (bOldPooled && GetSizeClass(OldSize) == GetSizeClass(NewSize))
+                return Ptr;
+
+            void* Buffer = Malloc(NewSize);
+            if (Ptr)
+            {
+                FMemory::Memcpy(Buffer, Ptr, FMath::Min(OldSize, NewSize));
+                Realloc(Ptr, OldSize, 0);
+            }
+            return Buffer;
+        }
+
+        if (!bOldPooled)
+        {
+            void* Buffer;
+            if (!Ptr)
+            {
+                Buffer = FMemory::Malloc(NewSize);
+                UNLUA_STAT_MEMORY_ALLOC(Buffer, Lua);
+            }
+            else
+            {
+                UNLUA_STAT_MEMORY_REALLOC(Ptr, Buffer, Lua);
+                Buffer = FMemory::Realloc(Ptr, NewSize);
+            }
+            return Buffer;
+        }
+
+        // grow from a pooled block
+        void* Buffer = FMemory::Malloc(NewSize);
+        UNLUA_STAT_MEMORY_ALLOC(Buffer, Lua);
+        FMemory::Memcpy(Buffer, Ptr, OldSize);
+        Free(Ptr, OldSize);
+        return Buffer;
+    }
+
+    void* FLuaSmallBlockPool::Refill(int32 SizeClass)
+    {
+        uint8* Chunk = (uint8*)FMemory::Malloc(ChunkSize, Granularity);
+        UNLUA_STAT_MEMORY_ALLOC(Chunk, Lua);
+        Chunks.Add(Chunk);
+
+        // carve the chunk into blocks of the size class, the first one is returned directly
+        const SIZE_T BlockSize = (SizeClass + 1) * Granularity;
+        const SIZE_T NumBlocks = ChunkSize / BlockSize;
+        FFreeBlock* Head = FreeLists[SizeClass];
+        for (SIZE_T i = NumBlocks - 1; i > 0; --i)
+        {
+            FFreeBlock* Block = (FFreeBlock*)(Chunk + i * BlockSize);
+            Block->Next = Head;
+            Head = Block;
+        }
+        FreeLists[SizeClass] = Head;
+        return Chunk;
+    }
+}
@@ -0,0 +1,82 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UnLua
+{
+    /**
+     * Size class free lists for the small objects of a lua_State, e.g. userdata of math structs (FVector etc.)
+     * created by every arithmetic operation. Freed blocks are reused by the next allocation of the same size class
+     * without touching the global allocator, memory is retained until the pool is destroyed with the lua_State.
+     */
+    class FLuaSmallBlockPool
+    {
+    public:
+        static constexpr SIZE_T Granularity = 16;
+        static constexpr SIZE_T MaxBlockSize = 128;
+        static constexpr int32 NumSizeClasses = MaxBlockSize / Granularity;
+
+        FLuaSmallBlockPool();
+
+        ~FLuaSmallBlockPool();
+
+        /**
+         * Allocation function with the same semantics of lua_Alloc, blocks larger than MaxBlockSize go to FMemory
+         */
+        void* Realloc(void* Ptr, SIZE_T OldSize, SIZE_T NewSize);
+
+        /**
+         * Get the number of bytes reserved by the pool
+         */
+        FORCEINLINE SIZE_T GetReservedSize() const { return (SIZE_T)Chunks.Num() * ChunkSize; }
+
+    private:
+        struct FFreeBlock
+        {
+            FFreeBlock* Next;
+        };
+
+        static constexpr SIZE_T ChunkSize = 64 * 1024;
+
+        static FORCEINLINE bool IsPooled(SIZE_T Size) { return Size <= MaxBlockSize; }
+
+        static FORCEINLINE int32 GetSizeClass(SIZE_T Size) { return (int32)((Size - 1) / Granularity); }
+
+        FORCEINLINE void* Malloc(SIZE_T Size)
+        {
+            const int32 SizeClass = GetSizeClass(Size);
+            FFreeBlock* Block = FreeLists[SizeClass];
+            if (UNLIKELY(!Block))
+                return Refill(SizeClass);
+            FreeLists[SizeClass] = Block->Next;
+            return Block;
+        }
+
+        FORCEINLINE void Free(void* Ptr, SIZE_T Size)
+        {
+            const int32 SizeClass = GetSizeClass(Size);
+            FFreeBlock* Block = (FFreeBlock*)Ptr;
+            Block->Next = FreeLists[SizeClass];
+            FreeLists[SizeClass] = Block;
+        }
+
+        void* Refill(int32 SizeClass);
+
+        FFreeBlock* FreeLists[NumSizeClasses];
+        TArray<void*> Chunks;
+    };
+}
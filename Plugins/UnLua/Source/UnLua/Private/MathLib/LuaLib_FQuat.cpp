@@ -125,6 +125,8 @@ static const luaL_Reg FQuatLib[] =
     {"Set", FQuat_Set},
     {"Mul", UnLua::TMathCalculation<FQuat, UnLua::TMul<FQuat>, true, UnLua::TMul<FQuat, unluaReal>>::Calculate},
     {"__mul", UnLua::TMathCalculation<FQuat, UnLua::TMul<FQuat>, false, UnLua::TMul<FQuat, unluaReal>>::Calculate},
+    {"MulAdd", UnLua::TMathInPlace<FQuat>::MulAdd},
+    {"Lerp", UnLua::TMathInPlace<FQuat>::Lerp},
     {"__tostring", UnLua::TMathUtils<FQuat>::ToString},
     {"__call", FQuat_New},
     {nullptr, nullptr}
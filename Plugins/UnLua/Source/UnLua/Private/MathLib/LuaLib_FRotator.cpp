@@ -111,6 +111,8 @@ static const luaL_Reg FRotatorLib[] =
     {"GetRightVector", FRotator_GetRightVector},
     {"GetUpVector", FRotator_GetUpVector},
     {"GetUnitAxis", FRotator_GetUnitAxis},
+    {"MulAdd", UnLua::TMathInPlace<FRotator>::MulAdd},
+    {"Lerp", UnLua::TMathInPlace<FRotator>::Lerp},
     {"__tostring", UnLua::TMathUtils<FRotator>::ToString},
     {"Set", FRotator_Set},
     {"__call", FRotator_New},
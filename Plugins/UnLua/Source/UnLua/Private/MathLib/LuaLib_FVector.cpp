@@ -114,6 +114,8 @@ static const luaL_Reg FVectorLib[] =
     {"__sub", UnLua::TMathCalculation<FVector, UnLua::TSub<unluaReal>>::Calculate},
     {"__mul", UnLua::TMathCalculation<FVector, UnLua::TMul<unluaReal>>::Calculate},
     {"__div", UnLua::TMathCalculation<FVector, UnLua::TDiv<unluaReal>>::Calculate},
+    {"MulAdd", UnLua::TMathInPlace<FVector>::MulAdd},
+    {"Lerp", UnLua::TMathInPlace<FVector>::Lerp},
     {"__tostring", UnLua::TMathUtils<FVector>::ToString},
     {"__unm", FVector_UNM},
     {"__call", FVector_New},
@@ -132,6 +132,8 @@ static const luaL_Reg FVector2DLib[] =
     {"__sub", UnLua::TMathCalculation<FVector2D, UnLua::TSub<unluaReal>>::Calculate},
     {"__mul", UnLua::TMathCalculation<FVector2D, UnLua::TMul<unluaReal>>::Calculate},
     {"__div", UnLua::TMathCalculation<FVector2D, UnLua::TDiv<unluaReal>>::Calculate},
+    {"MulAdd", UnLua::TMathInPlace<FVector2D>::MulAdd},
+    {"Lerp", UnLua::TMathInPlace<FVector2D>::Lerp},
     {"__tostring", UnLua::TMathUtils<FVector2D>::ToString},
     {"__unm", FVector2D_UNM},
     {"__call", FVector2D_New},
@@ -375,6 +375,56 @@ namespace UnLua
         }
     };
 
+    /**
+     * Helper to do multi-operand calculations in place, no intermediate userdata is created
+     */
+    template <typename T>
+    struct TMathInPlace
+    {
+        typedef typename TMathTypeTraits<T>::ScalarType ST;
+
+        static T* CheckOperand(lua_State* L, int32 Index)
+        {
+            T* V = (T*)GetCppInstanceFast(L, Index);
+            if (!V)
+                luaL_error(L, "invalid parameter %d", Index);
+            if (Index > 1 && GetTypeHash(L, Index) != GetTypeHash(L, 1))
+                luaL_error(L, "invalid parameters, incompatible types");
+            return V;
+        }
+
+        /**
+         * A:MulAdd(B, S), A = A + B * S
+         */
+        static int32 MulAdd(lua_State* L)
+        {
+            if (lua_gettop(L) != 3)
+                return luaL_error(L, "invalid parameters");
+
+            T* A = CheckOperand(L, 1);
+            const T* B = CheckOperand(L, 2);
+            const ST S = (ST)luaL_checknumber(L, 3);
+            *A += *B * S;
+            return 0;
+        }
+
+        /**
+         * Result:Lerp(A, B, Alpha), Result = FMath::Lerp(A, B, Alpha)
+         */
+        static int32 Lerp(lua_State* L)
+        {
+            if (lua_gettop(L) != 4)
+                return luaL_error(L, "invalid parameters");
+
+            T* Result = CheckOperand(L, 1);
+            const T* A = CheckOperand(L, 2);
+            const T* B = CheckOperand(L, 3);
+            const ST Alpha = (ST)luaL_checknumber(L, 4);
+            *Result = FMath::Lerp(*A, *B, Alpha);
+            return 0;
+        }
+    };
+
     template <typename T>
     FString ToStringWrapper(T* A) { return A->ToString(); }
 
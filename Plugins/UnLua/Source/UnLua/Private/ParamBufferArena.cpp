@@ -0,0 +1,126 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "ParamBufferArena.h"
+#include "UnLuaPrivate.h"
+
+namespace UnLua
+{
+    static constexpr int32 DefaultBlockSize = 64 * 1024;
+    static constexpr int32 BlockAlignment = 16;
+
+    FParamBufferArena::FScope::FScope(FParamBufferArena& InArena)
+        : Arena(InArena), Depth(InArena.PushScope())
+    {
+    }
+
+    FParamBufferArena::FScope::~FScope()
+    {
+        // also releases the scopes above which were skipped by a longjmp
+        Arena.PopScope(Depth);
+    }
+
+    FParamBufferArena::FParamBufferArena()
+        : Current(0), Top(0), UsedBefore(0), HighWaterMark(0)
+    {
+        Marks.Reserve(64);
+    }
+
+    FParamBufferArena::~FParamBufferArena()
+    {
+        FreeBlocks(0);
+    }
+
+    void FParamBufferArena::PopToMark(const FMark& Mark)
+    {
+        Current = Mark.BlockIndex;
+        Top = Mark.Offset;
+        UsedBefore = Mark.UsedBefore;
+
+#if !ENABLE_PERSISTENT_PARAM_BUFFER
+        // keep the first block only, the overflow blocks are released as soon as the arena is empty
+        if (Current == 0 && Top == 0 && Blocks.Num() > 1)
+            FreeBlocks(1);
+#endif
+    }
+
+    int32 FParamBufferArena::PushScope()
+    {
+        return Marks.Add(GetMark());
+    }
+
+    void FParamBufferArena::PopScope(int32 Depth)
+    {
+        // already released by an enclosing scope
+        if (Depth >= Marks.Num())
+            return;
+
+        PopToMark(Marks[Depth]);
+        Marks.SetNum(Depth, false);
+    }
+
+    void* FParamBufferArena::AllocSlow(int32 Size, int32 Alignment)
+    {
+        check(Alignment <= BlockAlignment);
+
+        // move to the next block which is large enough, the tail of the current block is wasted until popped
+        if (Blocks.Num() > 0)
+        {
+            UsedBefore += Blocks[Current].Size;
+            ++Current;
+        }
+
+        if (Current < Blocks.Num() && Blocks[Current].Size < Size)
+        {
+            // the cached block is too small, replace it with a larger one
+            FBlock& Block = Blocks[Current];
+            UNLUA_STAT_MEMORY_FREE(Block.Data, PersistentParamBuffer);
+            FMemory::Free(Block.Data);
+            Block.Size = FMath::Max(DefaultBlockSize, Align(Size, BlockAlignment));
+            Block.Data = (uint8*)FMemory::Malloc(Block.Size, BlockAlignment);
+            UNLUA_STAT_MEMORY_ALLOC(Block.Data, PersistentParamBuffer);
+        }
+
+        if (Current == Blocks.Num())
+        {
+            FBlock Block;
+            Block.Size = FMath::Max(DefaultBlockSize, Align(Size, BlockAlignment));
+            Block.Data = (uint8*)FMemory::Malloc(Block.Size, BlockAlignment);
+            UNLUA_STAT_MEMORY_ALLOC(Block.Data, PersistentParamBuffer);
+            Blocks.Add(Block);
+        }
+
+        Top = Size;
+        UpdateHighWaterMark();
+        return Blocks[Current].Data;
+    }
+
+    void FParamBufferArena::UpdateHighWaterMark()
+    {
+        HighWaterMark = FMath::Max(HighWaterMark, UsedBefore + Top);
+#if STATS
+        SET_MEMORY_STAT(STAT_UnLua_ParamArenaHighWater_Memory, HighWaterMark);
+#endif
+    }
+
+    void FParamBufferArena::FreeBlocks(int32 FirstBlockIndex)
+    {
+        for (int32 i = FirstBlockIndex; i < Blocks.Num(); ++i)
+        {
+            UNLUA_STAT_MEMORY_FREE(Blocks[i].Data, PersistentParamBuffer);
+            FMemory::Free(Blocks[i].Data);
+        }
+        Blocks.SetNum(FirstBlockIndex);
+    }
+}
@@ -0,0 +1,117 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UnLua
+{
+    /**
+     * Bump-pointer allocator for the parameter buffers of UFunction calls. Buffers are allocated and released
+     * in LIFO order, so nested and recursive calls (Lua -> UE -> Lua -> UE ...) always get their own frames
+     * without any heap allocation once the arena is warmed up.
+     */
+    class FParamBufferArena
+    {
+    public:
+        struct FMark
+        {
+            int32 BlockIndex;
+            int32 Offset;
+            int32 UsedBefore;   // bytes of the blocks before 'BlockIndex'
+        };
+
+        /**
+         * Release everything allocated in the scope when it ends. The marks live in the arena, a scope skipped by
+         * a Lua error (longjmp) leaves its mark behind and is released together with the enclosing scope, so
+         * scopes should also be opened around every lua_pcall/lua_resume boundary.
+         */
+        class FScope final
+        {
+        public:
+            explicit FScope(FParamBufferArena& InArena);
+
+            ~FScope();
+
+        private:
+            FParamBufferArena& Arena;
+            int32 Depth;
+        };
+
+        FParamBufferArena();
+
+        ~FParamBufferArena();
+
+        FORCEINLINE void* Alloc(int32 Size, int32 Alignment)
+        {
+            if (Size <= 0)
+                return nullptr;
+
+            if (Blocks.Num() > 0)
+            {
+                const FBlock& Block = Blocks[Current];
+                const int32 Offset = (int32)(Align((UPTRINT)Block.Data + Top, (UPTRINT)Alignment) - (UPTRINT)Block.Data);
+                if (Offset + Size <= Block.Size)
+                {
+                    Top = Offset + Size;
+                    if (UsedBefore + Top > HighWaterMark)
+                        UpdateHighWaterMark();
+                    return Block.Data + Offset;
+                }
+            }
+            return AllocSlow(Size, Alignment);
+        }
+
+        FORCEINLINE FMark GetMark() const { return {Current, Top, UsedBefore}; }
+
+        void PopToMark(const FMark& Mark);
+
+        /**
+         * Push the current mark to the scope stack
+         * @return depth of the new scope
+         */
+        int32 PushScope();
+
+        /**
+         * Release the scope at the given depth and all scopes above it
+         */
+        void PopScope(int32 Depth);
+
+        /**
+         * Get the max number of bytes used by in-flight parameter buffers
+         */
+        FORCEINLINE int32 GetHighWaterMark() const { return HighWaterMark; }
+
+    private:
+        struct FBlock
+        {
+            uint8* Data;
+            int32 Size;
+        };
+
+        void* AllocSlow(int32 Size, int32 Alignment);
+
+        void UpdateHighWaterMark();
+
+        void FreeBlocks(int32 FirstBlockIndex);
+
+        TArray<FBlock> Blocks;
+        TArray<FMark> Marks;
+        int32 Current;
+        int32 Top;
+        int32 UsedBefore;
+        int32 HighWaterMark;
+    };
+}
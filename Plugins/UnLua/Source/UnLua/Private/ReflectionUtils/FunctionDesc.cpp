@@ -23,6 +23,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "LuaDeadLoopCheck.h"
+#include "ParamBufferArena.h"
 #include "Containers/StaticBitArray.h"
 
 /**
@@ -44,7 +45,6 @@ FFunctionDesc::FFunctionDesc(UFunction *InFunction, FParameterCollection *InDefa
     else
         LuaFunctionName = MakeUnique<FTCHARToUTF8>(*FuncName);
 #else
-    NumCalls = 0;
     LuaFunctionName = MakeUnique<FTCHARToUTF8>(*FuncName);
 #endif
     
@@ -53,22 +53,7 @@ FFunctionDesc::FFunctionDesc(UFunction *InFunction, FParameterCollection *InDefa
     const auto OuterClass = Cast<UClass>(InFunction->GetOuter());
     bInterfaceFunc = OuterClass && OuterClass->HasAnyClassFlags(CLASS_Interface) && OuterClass != UInterface::StaticClass();
 
-    // create persistent parameter buffer. memory for speed
-#if ENABLE_PERSISTENT_PARAM_BUFFER
-    Buffer = nullptr;
-    if (InFunction->ParmsSize > 0)
-    {
-        Buffer = FMemory::Malloc(InFunction->ParmsSize, 16);
-        FMemory::Memzero(Buffer, InFunction->ParmsSize);
-        UNLUA_STAT_MEMORY_ALLOC(Buffer, Lua)
-    }
-#endif
-
-    // pre-create OutParmRec. memory for speed
-#if !SUPPORTS_RPC_CALL
-    OutParmRec = nullptr;
-    FOutParmRec *CurrentOutParmRec = nullptr;
-#endif
+    EntryPoint = UnLua::FDeadLoopCheck::GetEntryPoint(InFunction);
 
     static const FName NAME_LatentInfo = TEXT("LatentInfo");
     Properties.Reserve(InFunction->NumParms);
@@ -89,24 +74,6 @@ FFunctionDesc::FFunctionDesc(UFunction *InFunction, FParameterCollection *InDefa
         {
             ++NumRefProperties;
 
-            // pre-create OutParmRec for 'out' property
-#if !SUPPORTS_RPC_CALL
-            FOutParmRec *Out = (FOutParmRec*)FMemory::Malloc(sizeof(FOutParmRec), alignof(FOutParmRec));
-            UNLUA_STAT_MEMORY_ALLOC(Out, OutParmRec);
-            Out->PropAddr = Property->ContainerPtrToValuePtr<uint8>(Buffer);
-            Out->Property = Property;
-            if (CurrentOutParmRec)
-            {
-                CurrentOutParmRec->NextOutParm = Out;
-                CurrentOutParmRec = Out;
-            }
-            else
-            {
-                OutParmRec = Out;
-                CurrentOutParmRec = Out;
-            }
-#endif
-
             if (!Property->HasAnyPropertyFlags(CPF_ConstParm))
             {
                 OutPropertyIndices.Add(Index);                          // non-const reference property
@@ -114,11 +81,8 @@ FFunctionDesc::FFunctionDesc(UFunction *InFunction, FParameterCollection *InDefa
         }
     }
 
-#if !SUPPORTS_RPC_CALL
-    if (CurrentOutParmRec)
-    {
-        CurrentOutParmRec->NextOutParm = nullptr;
-    }
+#if ENABLE_FAST_NATIVE_CALL
+    InitFastCall(InFunction);
 #endif
 }
 
@@ -130,26 +94,6 @@ FFunctionDesc::~FFunctionDesc()
 #if UNLUA_ENABLE_DEBUG != 0
     UE_LOG(LogUnLua, Log, TEXT("~FFunctionDesc : %s,%p"), *FuncName, this);
 #endif
-
-    // free persistent parameter buffer
-#if ENABLE_PERSISTENT_PARAM_BUFFER
-    if (Buffer)
-    {
-        UNLUA_STAT_MEMORY_FREE(Buffer, PersistentParamBuffer);
-        FMemory::Free(Buffer);
-    }
-#endif
-
-    // free pre-created OutParmRec
-#if !SUPPORTS_RPC_CALL
-    while (OutParmRec)
-    {
-        FOutParmRec *NextOut = OutParmRec->NextOutParm;
-        UNLUA_STAT_MEMORY_FREE(OutParmRec, OutParmRec);
-        FMemory::Free(OutParmRec);
-        OutParmRec = NextOut;
-    }
-#endif
 }
 
 
@@ -168,14 +112,14 @@ void FFunctionDesc::CallLua(lua_State* L, lua_Integer FunctionRef, lua_Integer S
 
     void* InParms = nullptr;
     FOutParmRec* OutParms = Stack.OutParms;
+    auto& Arena = *UnLua::FLuaEnv::FindEnvChecked(L).GetParamBufferArena();
+    UnLua::FParamBufferArena::FScope ArenaScope(Arena);
     const bool bUnpackParams = Stack.CurrentNativeFunction && Stack.Node != Stack.CurrentNativeFunction;
     if (bUnpackParams)
     {
-#if ENABLE_PERSISTENT_PARAM_BUFFER
-        InParms = Buffer;
-#endif
-        if (!InParms)
-            InParms = ParmsSize > 0 ? FMemory::Malloc(ParmsSize, 16) : nullptr;
+        InParms = Arena.Alloc(ParmsSize, Function->GetMinAlignment());
+        if (InParms)
+            FMemory::Memzero(InParms, ParmsSize);
 
         FOutParmRec* FirstOut = nullptr;
         FOutParmRec* LastOut = nullptr;
@@ -226,11 +170,6 @@ void FFunctionDesc::CallLua(lua_State* L, lua_Integer FunctionRef, lua_Integer S
     }
 
     CallLuaInternal(L, InParms , OutParms, RESULT_PARAM);
-
-#if !ENABLE_PERSISTENT_PARAM_BUFFER
-    if (bUnpackParams && InParms)
-        FMemory::Free(InParms);
-#endif
 }
 
 bool FFunctionDesc::CallLua(lua_State* L, int32 LuaRef, void* Params, UObject* Self)
@@ -288,6 +227,12 @@ int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
     if (Object->IsUnreachable())
         return luaL_error(L, "attempt to call UFunction '%s' on Unreachable object '%s'.", TCHAR_TO_UTF8(*FuncName), TCHAR_TO_UTF8(*Object->GetName()));
 
+#if ENABLE_FAST_NATIVE_CALL
+    int32 NumFastReturnValues;
+    if (bFastCall && TryCallFast(L, Object, NumParams, FirstParamIndex, NumFastReturnValues))
+        return NumFastReturnValues;
+#endif
+
 #if SUPPORTS_RPC_CALL
     int32 Callspace = Object->GetFunctionCallspace(Function.Get(), nullptr);
     bool bRemote = Callspace & FunctionCallspace::Remote;
@@ -297,9 +242,6 @@ int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
     bool bLocal = true;
 #endif
 
-    FFlagArray CleanupFlags;
-    void *Params = PreCall(L, NumParams, FirstParamIndex, CleanupFlags, Userdata);      // prepare values of properties
-
     UFunction *FinalFunction = Function.Get();
     if (bInterfaceFunc)
     {
@@ -309,12 +251,6 @@ int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
         if (!FinalFunction)
         {
             UNLUA_LOGERROR(L, LogUnLua, Error, TEXT("ERROR! Can't find UFunction '%s' in target object!"), *FuncName);
-
-#if !ENABLE_PERSISTENT_PARAM_BUFFER
-            if (Params)
-                FMemory::Free(Params);
-#endif
-
             return 0;
         }
 #if UE_BUILD_DEBUG
@@ -349,19 +285,36 @@ int32 FFunctionDesc::CallUE(lua_State *L, int32 NumParams, void *Userdata)
     }
 #endif
 
+    // parameters are allocated from the arena of this env, every call (including recursive ones) gets its own frame
+    auto& Arena = *UnLua::FLuaEnv::FindEnvChecked(L).GetParamBufferArena();
+    UnLua::FParamBufferArena::FScope ArenaScope(Arena);
+
+    FFlagArray CleanupFlags;
+    void *Params = PreCall(L, Arena, NumParams, FirstParamIndex, CleanupFlags, Userdata);      // prepare values of properties
+
     // call the UFuncton...
-#if !SUPPORTS_RPC_CALL
-    if (FinalFunction == Function && FinalFunction->HasAnyFunctionFlags(FUNC_Native) && NumCalls == 1)
+    if (bLocal && !bRemote && FinalFunction->HasAnyFunctionFlags(FUNC_Native))
     {
-        //FMemory::Memzero((uint8*)Params + FinalFunction->ParmsSize, FinalFunction->PropertiesSize - FinalFunction->ParmsSize);
+        // invoke the native function directly, the same as UObject::ProcessEvent does but without copying parameters
+        FFrame NewStack(Object, FinalFunction, Params, nullptr, GetChildProperties(FinalFunction));
+        FOutParmRec** LastOut = &NewStack.OutParms;
+        for (TFieldIterator<FProperty> It(FinalFunction); It && (It->PropertyFlags & CPF_Parm); ++It)
+        {
+            FProperty* Property = *It;
+            if (!(Property->PropertyFlags & CPF_OutParm))
+                continue;
+            FOutParmRec* Out = (FOutParmRec*)Arena.Alloc(sizeof(FOutParmRec), alignof(FOutParmRec));
+            Out->PropAddr = Property->ContainerPtrToValuePtr<uint8>(Params);
+            Out->Property = Property;
+            *LastOut = Out;
+            LastOut = &Out->NextOutParm;
+        }
+        *LastOut = nullptr;
+
         uint8* ReturnValueAddress = FinalFunction->ReturnValueOffset != MAX_uint16 ? (uint8*)Params + FinalFunction->ReturnValueOffset : nullptr;
-        FMemory::Memcpy(Buffer, Params, Function->ParmsSize);
-        FFrame NewStack(Object, FinalFunction, Params, nullptr, GetChildProperties(Function));
-        NewStack.OutParms = OutParmRec;
         FinalFunction->Invoke(Object, NewStack, ReturnValueAddress);
     }
     else
-#endif
     {   
         // Func_NetMuticast both remote and local
         // local automatic checked remote and local,so local first
@@ -389,8 +342,11 @@ int32 FFunctionDesc::ExecuteDelegate(lua_State *L, int32 NumParams, int32 FirstP
         return 0;
     }
 
+    auto& Arena = *UnLua::FLuaEnv::FindEnvChecked(L).GetParamBufferArena();
+    UnLua::FParamBufferArena::FScope ArenaScope(Arena);
+
     FFlagArray CleanupFlags;
-    void *Params = PreCall(L, NumParams, FirstParamIndex, CleanupFlags);
+    void *Params = PreCall(L, Arena, NumParams, FirstParamIndex, CleanupFlags);
     ScriptDelegate->ProcessDelegate<UObject>(Params);
     int32 NumReturnValues = PostCall(L, NumParams, FirstParamIndex, Params, CleanupFlags);
     return NumReturnValues;
@@ -406,8 +362,11 @@ void FFunctionDesc::BroadcastMulticastDelegate(lua_State *L, int32 NumParams, in
         return;
     }
 
+    auto& Arena = *UnLua::FLuaEnv::FindEnvChecked(L).GetParamBufferArena();
+    UnLua::FParamBufferArena::FScope ArenaScope(Arena);
+
     FFlagArray CleanupFlags;
-    void *Params = PreCall(L, NumParams, FirstParamIndex, CleanupFlags);
+    void *Params = PreCall(L, Arena, NumParams, FirstParamIndex, CleanupFlags);
     ScriptDelegate->ProcessMulticastDelegate<UObject>(Params);
     PostCall(L, NumParams, FirstParamIndex, Params, CleanupFlags);      // !!! have no return values for multi-cast delegates
 }
@@ -415,17 +374,10 @@ void FFunctionDesc::BroadcastMulticastDelegate(lua_State *L, int32 NumParams, in
 /**
  * Prepare values of properties for the UFunction
  */
-void* FFunctionDesc::PreCall(lua_State* L, int32 NumParams, int32 FirstParamIndex, FFlagArray& CleanupFlags, void* Userdata)
+void* FFunctionDesc::PreCall(lua_State* L, UnLua::FParamBufferArena& Arena, int32 NumParams, int32 FirstParamIndex, FFlagArray& CleanupFlags, void* Userdata)
 {
-#if ENABLE_PERSISTENT_PARAM_BUFFER
-    void* Params = Buffer;
-#else
-    void* Params = Function->ParmsSize > 0 ? FMemory::Malloc(Function->ParmsSize, 16) : nullptr;
-#endif
-
-#if !SUPPORTS_RPC_CALL
-    ++NumCalls;
-#endif
+    // the buffer is released when the caller's arena scope ends
+    void* Params = Arena.Alloc(ParmsSize, Function->GetMinAlignment());
 
     int32 ParamIndex = 0;
     for (int32 i = 0; i < Properties.Num(); ++i)
@@ -557,17 +509,245 @@ int32 FFunctionDesc::PostCall(lua_State * L, int32 NumParams, int32 FirstParamIn
         }
     }
 
-#if !SUPPORTS_RPC_CALL
-    --NumCalls;
+    return NumReturnValues;
+}
+
+#if ENABLE_FAST_NATIVE_CALL
+bool FFunctionDesc::GetFastParamType(const FProperty* Property, bool bReturn, EFastParamType& OutType)
+{
+    if (Property->ArrayDim != 1)
+        return false;
+
+    const auto Class = Property->GetClass();
+    if (Class == FBoolProperty::StaticClass())
+    {
+        OutType = EFastParamType::Bool;
+        return ((const FBoolProperty*)Property)->IsNativeBool();
+    }
+    if (Class == FByteProperty::StaticClass())
+    {
+        OutType = EFastParamType::Byte;
+        return true;
+    }
+    if (Class == FEnumProperty::StaticClass())
+    {
+        OutType = EFastParamType::Byte;
+        return ((const FEnumProperty*)Property)->GetUnderlyingProperty()->GetClass() == FByteProperty::StaticClass();
+    }
+    if (Class == FIntProperty::StaticClass())
+    {
+        OutType = EFastParamType::Int32;
+        return true;
+    }
+    if (Class == FInt64Property::StaticClass())
+    {
+        OutType = EFastParamType::Int64;
+        return true;
+    }
+    if (Class == FFloatProperty::StaticClass())
+    {
+        OutType = EFastParamType::Float;
+        return true;
+    }
+    if (Class == FDoubleProperty::StaticClass())
+    {
+        OutType = EFastParamType::Double;
+        return true;
+    }
+    if (Class == FObjectProperty::StaticClass())
+    {
+        OutType = EFastParamType::Object;
+        return true;
+    }
+    if (Class == FStructProperty::StaticClass())
+    {
+        // return values are pushed by property descriptors, it's safe for all structs
+        OutType = EFastParamType::Struct;
+        if (bReturn)
+            return true;
+
+#if ENABLE_TYPE_CHECK == 1
+        // struct type checking needs the metatable, leave it to the reflection path
+        return false;
+#else
+        const UScriptStruct* Struct = ((const FStructProperty*)Property)->Struct;
+        return Struct == TBaseStructure<FVector>::Get()
+            || Struct == TBaseStructure<FVector2D>::Get()
+            || Struct == TBaseStructure<FRotator>::Get();
+#endif
+    }
+    return false;
+}
+
+/**
+ * Build the parameter list for fast native call. Only native functions which have POD parameters without
+ * out/ref/default values and run locally in any net mode are supported, the others always go through PreCall/PostCall.
+ */
+void FFunctionDesc::InitFastCall(UFunction* InFunction)
+{
+    bFastCall = false;
+
+    // functions whose callspace depends on the net role must go through GetFunctionCallspace
+    if (!InFunction->HasAnyFunctionFlags(FUNC_Native) || InFunction->HasAnyFunctionFlags(FUNC_Net | FUNC_BlueprintCosmetic | FUNC_BlueprintAuthorityOnly))
+        return;
+
+    if (bInterfaceFunc || IsLatentFunction() || NumRefProperties > 0 || InFunction->IsA<ULuaFunction>())
+        return;
+
+    FastParams.Reserve(Properties.Num());
+    for (int32 i = 0; i < Properties.Num(); ++i)
+    {
+        FProperty* Property = Properties[i]->GetProperty();
+        const bool bReturn = i == ReturnPropertyIndex;
+        EFastParamType Type;
+        if (!GetFastParamType(Property, bReturn, Type))
+        {
+            FastParams.Empty();
+            return;
+        }
+
+        FFastParam Param;
+        Param.Property = Property;
+        Param.Offset = Property->GetOffset_ForInternal();
+        Param.Size = Property->GetSize();
+        Param.Type = Type;
+        if (bReturn)
+            FastReturn = Param;
+        else
+            FastParams.Add(Param);
+    }
+
+    bFastCall = true;
+}
+
+bool FFunctionDesc::TryCallFast(lua_State* L, UObject* Object, int32 NumParams, int32 FirstParamIndex, int32& NumReturnValues)
+{
+    // missing arguments need default values, extra arguments may be used to copy back return values
+    if (NumParams != FastParams.Num())
+        return false;
+
+    UFunction* FinalFunction = Function.Get();
+
+#if ENABLE_TYPE_CHECK && WITH_EDITOR
+    if (!Object->IsA(FinalFunction->GetOuterUClass()))
+        return false;
 #endif
 
-#if !ENABLE_PERSISTENT_PARAM_BUFFER
-    if (Params)
-        FMemory::Free(Params);
-#endif	
+    // parameters live on the native stack, so recursive calls never share the buffer
+    uint8* Params = (uint8*)FMemory_Alloca_Aligned(ParmsSize > 0 ? ParmsSize : 1, FinalFunction->GetMinAlignment());
+    FMemory::Memzero(Params, ParmsSize);
 
-    return NumReturnValues;
+    for (int32 i = 0; i < FastParams.Num(); ++i)
+    {
+        const FFastParam& Param = FastParams[i];
+        const int32 Index = FirstParamIndex + i;
+        uint8* ValuePtr = Params + Param.Offset;
+        switch (Param.Type)
+        {
+        case EFastParamType::Bool:
+            if (lua_type(L, Index) != LUA_TBOOLEAN)
+                return false;
+            *(bool*)ValuePtr = lua_toboolean(L, Index) != 0;
+            break;
+        case EFastParamType::Byte:
+        case EFastParamType::Int32:
+        case EFastParamType::Int64:
+            {
+                if (!lua_isinteger(L, Index))
+                    return false;
+                const lua_Integer Value = lua_tointeger(L, Index);
+                if (Param.Type == EFastParamType::Byte)
+                    *ValuePtr = (uint8)Value;
+                else if (Param.Type == EFastParamType::Int32)
+                    *(int32*)ValuePtr = (int32)Value;
+                else
+                    *(int64*)ValuePtr = (int64)Value;
+            }
+            break;
+        case EFastParamType::Float:
+        case EFastParamType::Double:
+            if (lua_type(L, Index) != LUA_TNUMBER)
+                return false;
+            if (Param.Type == EFastParamType::Float)
+                *(float*)ValuePtr = (float)lua_tonumber(L, Index);
+            else
+                *(double*)ValuePtr = lua_tonumber(L, Index);
+            break;
+        case EFastParamType::Object:
+            {
+                UObject* Value = nullptr;
+                if (!lua_isnil(L, Index))
+                {
+                    Value = UnLua::GetUObject(L, Index, false);
+                    if (!Value || UnLua::LowLevel::IsReleasedPtr(Value))
+                        return false;
+#if ENABLE_TYPE_CHECK == 1
+                    if (!Value->GetClass()->IsChildOf(((FObjectProperty*)Param.Property)->PropertyClass))
+                        return false;
+#endif
+                }
+                *(UObject**)ValuePtr = Value;
+            }
+            break;
+        case EFastParamType::Struct:
+            {
+                const void* Value = GetCppInstanceFast(L, Index);
+                if (!Value)
+                    return false;
+                FMemory::Memcpy(ValuePtr, Value, Param.Size);
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+
+    uint8* ReturnValueAddress = ReturnPropertyIndex > INDEX_NONE ? Params + FastReturn.Offset : nullptr;
+    if (ReturnValueAddress && FastReturn.Type == EFastParamType::Struct)
+        FastReturn.Property->InitializeValue(ReturnValueAddress);
+
+    FFrame NewStack(Object, FinalFunction, Params, nullptr, GetChildProperties(FinalFunction));
+    FinalFunction->Invoke(Object, NewStack, ReturnValueAddress);
+
+    if (!ReturnValueAddress)
+    {
+        NumReturnValues = 0;
+        return true;
+    }
+
+    switch (FastReturn.Type)
+    {
+    case EFastParamType::Bool:
+        lua_pushboolean(L, *(bool*)ReturnValueAddress);
+        break;
+    case EFastParamType::Byte:
+        lua_pushinteger(L, *ReturnValueAddress);
+        break;
+    case EFastParamType::Int32:
+        lua_pushinteger(L, *(int32*)ReturnValueAddress);
+        break;
+    case EFastParamType::Int64:
+        lua_pushinteger(L, *(int64*)ReturnValueAddress);
+        break;
+    case EFastParamType::Float:
+        lua_pushnumber(L, *(float*)ReturnValueAddress);
+        break;
+    case EFastParamType::Double:
+        lua_pushnumber(L, *(double*)ReturnValueAddress);
+        break;
+    case EFastParamType::Object:
+        Properties[ReturnPropertyIndex]->ReadValue_InContainer(L, Params, true);
+        break;
+    default:
+        Properties[ReturnPropertyIndex]->ReadValue_InContainer(L, Params, true);
+        FastReturn.Property->DestroyValue(ReturnValueAddress);
+        break;
+    }
+
+    NumReturnValues = 1;
+    return true;
 }
+#endif
 
 /**
  * Get OutParmRec for a non-const reference property
@@ -596,7 +776,7 @@ bool FFunctionDesc::CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *O
     const auto ErrorHandlerIndex = lua_gettop(L) - 2;
 
     const auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
-    const auto DanglingGuard = Env.GetDanglingCheck()->MakeGuard();
+    const UnLua::FDanglingCheck::FGuard DanglingGuard(Env.GetDanglingCheck());
 
     // prepare parameters for Lua function
     for (const auto& Property : Properties)
@@ -612,7 +792,8 @@ bool FFunctionDesc::CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *O
     if (ReturnPropertyIndex == INDEX_NONE)
         NumParams++;
 
-    const auto Guard = Env.GetDeadLoopCheck()->MakeGuard();
+    const UnLua::FDeadLoopCheck::FGuard Guard(Env.GetDeadLoopCheck(), EntryPoint, *FuncName);
+    const UnLua::FParamBufferArena::FScope ArenaScope(*Env.GetParamBufferArena());
     if (lua_pcall(L, NumParams, LUA_MULTRET, -(NumParams + 2)) != LUA_OK)
     {
         lua_settop(L, ErrorHandlerIndex - 1);
@@ -17,11 +17,17 @@
 #include "lua.hpp"
 #include "Registries/FunctionRegistry.h"
 #include "Containers/StaticBitArray.h"
+#include "LuaDeadLoopCheck.h"
 
 struct lua_State;
 struct FParameterCollection;
 class FPropertyDesc;
 
+namespace UnLua
+{
+    class FParamBufferArena;
+}
+
 /**
  * Function descriptor
  */
@@ -116,20 +122,53 @@ public:
 
 private:
     typedef TStaticBitArray<64U> FFlagArray;
-    void* PreCall(lua_State* L, int32 NumParams, int32 FirstParamIndex, FFlagArray& CleanupFlags, void* Userdata = nullptr);
+    void* PreCall(lua_State* L, UnLua::FParamBufferArena& Arena, int32 NumParams, int32 FirstParamIndex, FFlagArray& CleanupFlags, void* Userdata = nullptr);
     int32 PostCall(lua_State* L, int32 NumParams, int32 FirstParamIndex, void* Params, const FFlagArray& CleanupFlags);
 
     bool CallLuaInternal(lua_State *L, void *InParams, FOutParmRec *OutParams, void *RetValueAddress) const;
 
+#if ENABLE_FAST_NATIVE_CALL
+    /**
+     * Parameter types which can be moved between Lua stack and parameter buffer without property descriptors
+     */
+    enum class EFastParamType : uint8
+    {
+        Bool,
+        Byte,
+        Int32,
+        Int64,
+        Float,
+        Double,
+        Object,
+        Struct,
+    };
+
+    struct FFastParam
+    {
+        FProperty* Property;
+        int32 Offset;
+        int32 Size;
+        EFastParamType Type;
+    };
+
+    static bool GetFastParamType(const FProperty* Property, bool bReturn, EFastParamType& OutType);
+
+    void InitFastCall(UFunction* InFunction);
+
+    /**
+     * Call a native UFunction which only has POD parameters, reading arguments directly from Lua stack
+     *
+     * @return - false if the arguments don't match the fast path, the caller should fallback to the reflection path
+     */
+    bool TryCallFast(lua_State* L, UObject* Object, int32 NumParams, int32 FirstParamIndex, int32& NumReturnValues);
+
+    TArray<FFastParam> FastParams;
+    FFastParam FastReturn;
+    bool bFastCall;
+#endif
+
     TWeakObjectPtr<UFunction> Function;
     FString FuncName;
-#if ENABLE_PERSISTENT_PARAM_BUFFER
-    void *Buffer;
-#endif
-#if !SUPPORTS_RPC_CALL
-    FOutParmRec *OutParmRec;
-    uint8 NumCalls;                 // RECURSE_LIMIT is 120 or 250 which is less than 256, so use a byte...
-#endif
     TArray<TUniquePtr<FPropertyDesc>> Properties;
     TArray<int32> OutPropertyIndices;
     FParameterCollection *DefaultParams;
@@ -138,6 +177,7 @@ private:
     uint8 NumRefProperties;
     uint8 bStaticFunc : 1;
     uint8 bInterfaceFunc : 1;
+    UnLua::FDeadLoopCheck::EEntryPoint EntryPoint;
     int32 ParmsSize;
     TUniquePtr<FTCHARToUTF8> LuaFunctionName;
 };
@@ -0,0 +1,153 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "PropertyAccessor.h"
+
+namespace UnLua
+{
+    uint32 FPropertyAccessor::CurrentGeneration = 1;
+
+    template <typename T>
+    static void ReadInteger(lua_State* L, const void* ValuePtr)
+    {
+        lua_pushinteger(L, (lua_Integer)*(const T*)ValuePtr);
+    }
+
+    template <typename T>
+    static void WriteInteger(lua_State* L, void* ValuePtr, int32 IndexInStack)
+    {
+        *(T*)ValuePtr = (T)lua_tointeger(L, IndexInStack);
+    }
+
+    template <typename T>
+    static void ReadNumber(lua_State* L, const void* ValuePtr)
+    {
+        lua_pushnumber(L, (lua_Number)*(const T*)ValuePtr);
+    }
+
+    template <typename T>
+    static void WriteNumber(lua_State* L, void* ValuePtr, int32 IndexInStack)
+    {
+        *(T*)ValuePtr = (T)lua_tonumber(L, IndexInStack);
+    }
+
+    static void ReadBool(lua_State* L, const void* ValuePtr)
+    {
+        lua_pushboolean(L, *(const bool*)ValuePtr);
+    }
+
+    static void WriteBool(lua_State* L, void* ValuePtr, int32 IndexInStack)
+    {
+        *(bool*)ValuePtr = lua_toboolean(L, IndexInStack) != 0;
+    }
+
+    template <typename T>
+    static FORCEINLINE void SetIntegerFuncs(FPropertyAccessor& Accessor)
+    {
+        Accessor.ReadFunc = ReadInteger<T>;
+        Accessor.WriteFunc = WriteInteger<T>;
+    }
+
+    /**
+     * Select the fast path according to the property class, which must behave the same as the descriptor
+     */
+    static void SetAccessFuncs(FPropertyAccessor& Accessor, const FProperty* Property)
+    {
+        Accessor.ReadFunc = nullptr;
+        Accessor.WriteFunc = nullptr;
+
+        if (Property->ArrayDim != 1)
+            return;
+
+        const FFieldClass* Class = Property->GetClass();
+        if (Class == FBoolProperty::StaticClass())
+        {
+            if (((const FBoolProperty*)Property)->IsNativeBool())
+            {
+                Accessor.ReadFunc = ReadBool;
+                Accessor.WriteFunc = WriteBool;
+            }
+        }
+        else if (Class == FInt8Property::StaticClass())
+            SetIntegerFuncs<int8>(Accessor);
+        else if (Class == FInt16Property::StaticClass())
+            SetIntegerFuncs<int16>(Accessor);
+        else if (Class == FIntProperty::StaticClass())
+            SetIntegerFuncs<int32>(Accessor);
+        else if (Class == FInt64Property::StaticClass())
+            SetIntegerFuncs<int64>(Accessor);
+        else if (Class == FByteProperty::StaticClass())
+        {
+            if (!((const FByteProperty*)Property)->Enum)
+                SetIntegerFuncs<uint8>(Accessor);
+        }
+        else if (Class == FUInt16Property::StaticClass())
+            SetIntegerFuncs<uint16>(Accessor);
+        else if (Class == FUInt32Property::StaticClass())
+            SetIntegerFuncs<uint32>(Accessor);
+        else if (Class == FUInt64Property::StaticClass())
+            SetIntegerFuncs<uint64>(Accessor);
+        else if (Class == FFloatProperty::StaticClass())
+        {
+            Accessor.ReadFunc = ReadNumber<float>;
+            Accessor.WriteFunc = WriteNumber<float>;
+        }
+        else if (Class == FDoubleProperty::StaticClass())
+        {
+            Accessor.ReadFunc = ReadNumber<double>;
+            Accessor.WriteFunc = WriteNumber<double>;
+        }
+    }
+
+    void FPropertyAccessor::Push(lua_State* L, TSharedPtr<FPropertyDesc> Property)
+    {
+        const auto Userdata = lua_newuserdata(L, sizeof(FPropertyAccessor));
+        if (luaL_newmetatable(L, METATABLE_NAME))
+        {
+            lua_pushcfunction(L, Release);
+            lua_setfield(L, -2, "__gc");
+        }
+        lua_setmetatable(L, -2);
+
+        const auto Accessor = new(Userdata) FPropertyAccessor;
+        Accessor->Property = Property;
+        Accessor->Desc = Property.Get();
+        Accessor->OwnerClass = nullptr;
+        Accessor->Offset = 0;
+        Accessor->Generation = 0;
+        Accessor->ReadFunc = nullptr;
+        Accessor->WriteFunc = nullptr;
+        Accessor->Validate();
+    }
+
+    int FPropertyAccessor::Release(lua_State* L)
+    {
+        const auto Accessor = (FPropertyAccessor*)lua_touserdata(L, 1);
+        Accessor->~FPropertyAccessor();
+        return 0;
+    }
+
+    bool FPropertyAccessor::Validate()
+    {
+        if (!Desc->IsValid())
+            return false;
+
+        const FProperty* UProperty = Desc->GetProperty();
+        OwnerClass = UProperty->GetOwnerClass();
+        Offset = UProperty->GetOffset_ForInternal();
+        SetAccessFuncs(*this, UProperty);
+        Generation = CurrentGeneration;
+        return true;
+    }
+}
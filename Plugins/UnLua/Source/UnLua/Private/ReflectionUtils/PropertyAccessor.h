@@ -0,0 +1,109 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "PropertyDesc.h"
+
+namespace UnLua
+{
+    /**
+     * Compact accessor of a reflected property, cached in the metatable of its class. It has its own metatable and
+     * shares the layout of TSharedPtr<FPropertyDesc> at the beginning, so it can still be used as the shared pointer
+     * of the descriptor. The descriptor is validated once per generation, which increases when any reflected type is
+     * unregistered or any property descriptor is released.
+     */
+    struct FPropertyAccessor
+    {
+        typedef void (*FReadFunc)(lua_State* L, const void* ValuePtr);
+        typedef void (*FWriteFunc)(lua_State* L, void* ValuePtr, int32 IndexInStack);
+
+        TSharedPtr<FPropertyDesc> Property;     // must be the first member
+        FPropertyDesc* Desc;
+        FReadFunc ReadFunc;                     // fast path for numeric and bool properties, or null
+        FWriteFunc WriteFunc;
+        UClass* OwnerClass;
+        int32 Offset;
+        uint32 Generation;
+
+        /**
+         * Push an accessor of the property, it can be read as TSharedPtr<FPropertyDesc> too
+         */
+        static void Push(lua_State* L, TSharedPtr<FPropertyDesc> Property);
+
+        /**
+         * Get the accessor at the given index, null if the value isn't an accessor
+         */
+        static FORCEINLINE FPropertyAccessor* Get(lua_State* L, int32 Index)
+        {
+            return (FPropertyAccessor*)luaL_testudata(L, Index, METATABLE_NAME);
+        }
+
+        /**
+         * Invalidate all accessors, they will be validated again on next access
+         */
+        static FORCEINLINE void Invalidate() { ++CurrentGeneration; }
+
+        FORCEINLINE bool IsValid()
+        {
+#if WITH_EDITOR
+            // properties may be recreated by recompiling blueprints in editor
+            return Desc->IsValid();
+#else
+            if (LIKELY(Generation == CurrentGeneration))
+                return true;
+            return Validate();
+#endif
+        }
+
+        FORCEINLINE bool CheckOwner(lua_State* L, void* ContainerPtr) const
+        {
+#if ENABLE_TYPE_CHECK == 1
+            if (OwnerClass && !((UObject*)ContainerPtr)->IsA(OwnerClass))
+            {
+                luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("Access property from invalid owner. %s should be a %s."), *((UObject*)ContainerPtr)->GetName(), *OwnerClass->GetName())));
+                return false;
+            }
+#endif
+            return true;
+        }
+
+        FORCEINLINE void Read(lua_State* L, const void* ContainerPtr) const
+        {
+            const void* ValuePtr = (const uint8*)ContainerPtr + Offset;
+            if (ReadFunc)
+                ReadFunc(L, ValuePtr);
+            else
+                Desc->GetValueInternal(L, ValuePtr, false);
+        }
+
+        FORCEINLINE void Write(lua_State* L, void* ContainerPtr, int32 IndexInStack) const
+        {
+            void* ValuePtr = (uint8*)ContainerPtr + Offset;
+            if (WriteFunc)
+                WriteFunc(L, ValuePtr, IndexInStack);
+            else
+                Desc->SetValueInternal(L, ValuePtr, IndexInStack, true);
+        }
+
+    private:
+        bool Validate();
+
+        static int Release(lua_State* L);
+
+        static constexpr const char* METATABLE_NAME = "UnLuaPropertyAccessor";
+
+        static uint32 CurrentGeneration;
+    };
+}
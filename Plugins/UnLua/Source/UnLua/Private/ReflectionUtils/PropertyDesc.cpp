@@ -20,6 +20,8 @@
 #include "Containers/LuaSet.h"
 #include "Containers/LuaMap.h"
 #include "ObjectReferencer.h"
+#include "PropertyAccessor.h"
+#include "UnLuaSettings.h"
 
 FPropertyDesc::FPropertyDesc(FProperty *InProperty) : Property(InProperty) 
 {
@@ -28,6 +30,12 @@ FPropertyDesc::FPropertyDesc(FProperty *InProperty) : Property(InProperty)
     Name = Property->GetName();
 }
 
+FPropertyDesc::~FPropertyDesc()
+{
+    // accessors may still refer to the released property
+    UnLua::FPropertyAccessor::Invalidate();
+}
+
 bool FPropertyDesc::IsValid() const
 {
     if (!PropertyPtr.IsValid())
@@ -598,13 +606,13 @@ public:
         }
         else
         {
-            lua_pushstring(L, TCHAR_TO_UTF8(*NameProperty->GetPropertyValue(ValuePtr).ToString()));
+            UnLua::FLuaEnv::FindEnvChecked(L).GetNameCache()->Push(L, NameProperty->GetPropertyValue(ValuePtr));
         }
     }
 
     virtual bool SetValueInternal(lua_State *L, void *ValuePtr, int32 IndexInStack, bool bCopyValue) const override
     {
-        NameProperty->SetPropertyValue(ValuePtr, FName(UTF8_TO_TCHAR(lua_tostring(L, IndexInStack))));
+        NameProperty->SetPropertyValue(ValuePtr, UnLua::FLuaEnv::FindEnvChecked(L).GetNameCache()->Get(L, IndexInStack));
         return true;
     }
 
@@ -642,13 +650,13 @@ public:
         }
         else
         {
-            lua_pushstring(L, TCHAR_TO_UTF8(*StringProperty->GetPropertyValue(ValuePtr)));
+            UnLua::FLuaNameCache::PushString(L, StringProperty->GetPropertyValue(ValuePtr));
         }
     }
 
     virtual bool SetValueInternal(lua_State *L, void *ValuePtr, int32 IndexInStack, bool bCopyValue) const override
     {
-        StringProperty->SetPropertyValue(ValuePtr, UTF8_TO_TCHAR(lua_tostring(L, IndexInStack)));
+        UnLua::FLuaNameCache::GetString(L, IndexInStack, *StringProperty->GetPropertyValuePtr(ValuePtr));
         return true;
     }
 
@@ -1300,6 +1308,175 @@ private:
     uint8 UserdataPadding;
 };
 
+/**
+ * Field layouts of the math structs which can be passed as plain Lua tables
+ */
+template <typename T>
+struct TValueStructLayout;
+
+template <>
+struct TValueStructLayout<FVector>
+{
+    enum { NUM_FIELDS = 3 };
+    static const char* GetFieldName(int32 i) { static const char* Names[] = {"X", "Y", "Z"}; return Names[i]; }
+};
+
+template <>
+struct TValueStructLayout<FVector2D>
+{
+    enum { NUM_FIELDS = 2 };
+    static const char* GetFieldName(int32 i) { static const char* Names[] = {"X", "Y"}; return Names[i]; }
+};
+
+template <>
+struct TValueStructLayout<FRotator>
+{
+    enum { NUM_FIELDS = 3 };
+    static const char* GetFieldName(int32 i) { static const char* Names[] = {"Pitch", "Yaw", "Roll"}; return Names[i]; }
+};
+
+/**
+ * Math struct property descriptor which reads values as plain Lua tables, e.g. {X = 1, Y = 2, Z = 3}.
+ * Tables with named fields or packed numbers ({1, 2, 3}) and userdata are all accepted when writing.
+ */
+template <typename T>
+class TValueStructPropertyDesc : public FScriptStructPropertyDesc
+{
+    typedef TValueStructLayout<T> FLayout;
+    typedef unluaReal FT;
+
+public:
+    explicit TValueStructPropertyDesc(FProperty *InProperty)
+        : FScriptStructPropertyDesc(InProperty)
+    {
+        static_assert(sizeof(T) == sizeof(FT) * FLayout::NUM_FIELDS, "unexpected struct layout");
+    }
+
+    using FScriptStructPropertyDesc::CopyBack;
+
+    virtual bool CopyBack(lua_State *L, int32 SrcIndexInStack, void *DestContainerPtr) override
+    {
+        if (lua_type(L, SrcIndexInStack) != LUA_TTABLE)
+            return FScriptStructPropertyDesc::CopyBack(L, SrcIndexInStack, DestContainerPtr);
+        if (!IsOutParameter())
+            return false;
+        ReadTable(L, SrcIndexInStack, Property->ContainerPtrToValuePtr<FT>(DestContainerPtr));
+        return true;
+    }
+
+    virtual bool CopyBack(lua_State *L, void *SrcContainerPtr, int32 DestIndexInStack) override
+    {
+        if (lua_type(L, DestIndexInStack) != LUA_TTABLE)
+            return FScriptStructPropertyDesc::CopyBack(L, SrcContainerPtr, DestIndexInStack);
+        if (!IsOutParameter())
+            return false;
+        WriteTable(L, Property->ContainerPtrToValuePtr<FT>(SrcContainerPtr), DestIndexInStack);
+        return true;
+    }
+
+    virtual void GetValueInternal(lua_State *L, const void *ValuePtr, bool bCreateCopy) const override
+    {
+        // always by value, a table can't reference the memory of the property
+        const FT* Fields = (const FT*)ValuePtr;
+        lua_createtable(L, 0, FLayout::NUM_FIELDS);
+        for (int32 i = 0; i < FLayout::NUM_FIELDS; ++i)
+        {
+            lua_pushnumber(L, Fields[i]);
+            lua_setfield(L, -2, FLayout::GetFieldName(i));
+        }
+    }
+
+    virtual bool SetValueInternal(lua_State *L, void *ValuePtr, int32 IndexInStack, bool bCopyValue) const override
+    {
+        if (lua_type(L, IndexInStack) != LUA_TTABLE)
+            return FScriptStructPropertyDesc::SetValueInternal(L, ValuePtr, IndexInStack, bCopyValue);
+        ReadTable(L, IndexInStack, (FT*)ValuePtr);
+        return true;
+    }
+
+#if ENABLE_TYPE_CHECK == 1
+    virtual bool CheckPropertyType(lua_State* L, int32 IndexInStack, FString& ErrorMsg, void* UserData) override
+    {
+        if (lua_type(L, IndexInStack) != LUA_TTABLE)
+            return FScriptStructPropertyDesc::CheckPropertyType(L, IndexInStack, ErrorMsg, UserData);
+
+        UnLua::FAutoStack AutoStack(L);
+        IndexInStack = lua_absindex(L, IndexInStack);
+        const bool bPacked = IsPacked(L, IndexInStack);
+        for (int32 i = 0; i < FLayout::NUM_FIELDS; ++i)
+        {
+            const int32 Type = bPacked ? lua_rawgeti(L, IndexInStack, i + 1) : lua_getfield(L, IndexInStack, FLayout::GetFieldName(i));
+            if (Type != LUA_TNIL && Type != LUA_TNUMBER)
+            {
+                ErrorMsg = FString::Printf(TEXT("number needed for field %s but got %s"), UTF8_TO_TCHAR(FLayout::GetFieldName(i)), UTF8_TO_TCHAR(lua_typename(L, Type)));
+                return false;
+            }
+            lua_pop(L, 1);
+        }
+        return true;
+    }
+#endif
+
+private:
+    static bool IsPacked(lua_State* L, int32 TableIndex)
+    {
+        const bool bPacked = lua_rawgeti(L, TableIndex, 1) != LUA_TNIL;
+        lua_pop(L, 1);
+        return bPacked;
+    }
+
+    static void ReadTable(lua_State* L, int32 TableIndex, FT* Fields)
+    {
+        TableIndex = lua_absindex(L, TableIndex);
+        const bool bPacked = IsPacked(L, TableIndex);
+        for (int32 i = 0; i < FLayout::NUM_FIELDS; ++i)
+        {
+            if (bPacked)
+                lua_rawgeti(L, TableIndex, i + 1);
+            else
+                lua_getfield(L, TableIndex, FLayout::GetFieldName(i));
+            Fields[i] = (FT)lua_tonumber(L, -1);
+            lua_pop(L, 1);
+        }
+    }
+
+    static void WriteTable(lua_State* L, const FT* Fields, int32 TableIndex)
+    {
+        TableIndex = lua_absindex(L, TableIndex);
+        const bool bPacked = IsPacked(L, TableIndex);
+        for (int32 i = 0; i < FLayout::NUM_FIELDS; ++i)
+        {
+            lua_pushnumber(L, Fields[i]);
+            if (bPacked)
+                lua_rawseti(L, TableIndex, i + 1);
+            else
+                lua_setfield(L, TableIndex, FLayout::GetFieldName(i));
+        }
+    }
+};
+
+bool IsValueStruct(const UScriptStruct *Struct)
+{
+    if (!GetDefault<UUnLuaSettings>()->bMathStructsAsTables)
+        return false;
+    return Struct == TBaseStructure<FVector>::Get() || Struct == TBaseStructure<FVector2D>::Get() || Struct == TBaseStructure<FRotator>::Get();
+}
+
+static FPropertyDesc* CreateScriptStructPropertyDesc(FProperty* InProperty)
+{
+    const UScriptStruct* Struct = CastFieldChecked<FStructProperty>(InProperty)->Struct;
+    if (InProperty->ArrayDim == 1 && IsValueStruct(Struct))
+    {
+        if (Struct == TBaseStructure<FVector>::Get())
+            return new TValueStructPropertyDesc<FVector>(InProperty);
+        if (Struct == TBaseStructure<FVector2D>::Get())
+            return new TValueStructPropertyDesc<FVector2D>(InProperty);
+        if (Struct == TBaseStructure<FRotator>::Get())
+            return new TValueStructPropertyDesc<FRotator>(InProperty);
+    }
+    return new FScriptStructPropertyDesc(InProperty);
+}
+
 /**
  * Delegate property descriptor
  */
@@ -1621,7 +1798,7 @@ FPropertyDesc* FPropertyDesc::Create(FProperty *InProperty)
         }
     case CPT_Struct:
         {
-            PropertyDesc = new FScriptStructPropertyDesc(InProperty);
+            PropertyDesc = CreateScriptStructPropertyDesc(InProperty);
             break;
         }
     case CPT_Delegate:
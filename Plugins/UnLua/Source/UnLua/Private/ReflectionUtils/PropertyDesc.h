@@ -34,14 +34,20 @@ enum
 
 struct lua_State;
 
+namespace UnLua { struct FPropertyAccessor; }
+
 /**
  * Property descriptor
  */
 class FPropertyDesc : public UnLua::ITypeInterface
 {
+    friend struct UnLua::FPropertyAccessor;
+
 public:
     static FPropertyDesc* Create(FProperty *InProperty);
 
+    virtual ~FPropertyDesc() override;
+
     /**
      * Check the validity of this property
      *
@@ -259,3 +265,8 @@ protected:
 };
 
 UNLUA_API int32 GetPropertyType(const FProperty *Property);
+
+/**
+ * Test if values of the struct are passed as plain Lua tables, see UUnLuaSettings::bMathStructsAsTables
+ */
+bool IsValueStruct(const UScriptStruct *Struct);
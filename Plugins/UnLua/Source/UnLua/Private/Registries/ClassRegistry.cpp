@@ -18,7 +18,9 @@
 #include "LowLevel.h"
 #include "LuaCore.h"
 #include "UELib.h"
+#include "UnLuaSettings.h"
 #include "ReflectionUtils/ClassDesc.h"
+#include "ReflectionUtils/PropertyAccessor.h"
 
 extern int32 UObject_Identical(lua_State* L);
 extern int32 UObject_Delete(lua_State* L);
@@ -33,6 +35,20 @@ namespace UnLua
     {
     }
 
+    void FClassRegistry::NotifyUObjectsDeleted(const TArray<UObject*>& Objects)
+    {
+        if (MetatableRefs.Num() == 0)
+            return;
+
+        const auto L = Env->GetMainState();
+        for (const auto Object : Objects)
+        {
+            int32 Ref;
+            if (MetatableRefs.RemoveAndCopyValue((UStruct*)Object, Ref))
+                luaL_unref(L, LUA_REGISTRYINDEX, Ref);
+        }
+    }
+
     FClassRegistry* FClassRegistry::Find(const lua_State* L)
     {
         const auto Env = FLuaEnv::FindEnv(L);
@@ -108,10 +124,17 @@ namespace UnLua
         FClassDesc* ClassDesc;
         if (!Classes.RemoveAndCopyValue((UStruct*)Type, ClassDesc))
             return false;
+
+        // properties of the deleted type may be cached by any class
+        FPropertyAccessor::Invalidate();
+
         ClassDesc->UnLoad();
         for (auto Pair : FLuaEnv::AllEnvs)
         {
             auto Registry = Pair.Value->GetClassRegistry();
+            int32 Ref;
+            if (Registry->MetatableRefs.RemoveAndCopyValue((UStruct*)Type, Ref))
+                luaL_unref(Pair.Key, LUA_REGISTRYINDEX, Ref);
             Registry->Unregister(ClassDesc);
         }
         return true;
@@ -184,10 +207,15 @@ namespace UnLua
             lua_pushcclosure(L, ScriptStruct_Compare, 1);
             lua_rawset(L, -4);
 
-            lua_pushstring(L, "__gc");
-            lua_pushvalue(L, -2);
-            lua_pushcclosure(L, ScriptStruct_Delete, 1);
-            lua_rawset(L, -4);
+            // ScriptStruct_Delete does nothing for native POD structs, skip the finalizer of their userdata
+            const bool bNoDestructor = ScriptStruct->IsNative() && (ScriptStruct->StructFlags & (STRUCT_IsPlainOldData | STRUCT_NoDestructor));
+            if (!bNoDestructor || !GetDefault<UUnLuaSettings>()->bPODStructsWithoutGC)
+            {
+                lua_pushstring(L, "__gc");
+                lua_pushvalue(L, -2);
+                lua_pushcclosure(L, ScriptStruct_Delete, 1);
+                lua_rawset(L, -4);
+            }
 
             lua_pushstring(L, "__call");
             lua_pushvalue(L, -2);
@@ -249,6 +277,28 @@ namespace UnLua
         return true;
     }
 
+    bool FClassRegistry::TrySetMetatable(lua_State* L, const UStruct* Type)
+    {
+        // a new type may reuse the memory of a deleted one
+        Env->FlushDeletedObjects();
+
+        if (const int32* Ref = MetatableRefs.Find(Type))
+        {
+            lua_rawgeti(L, LUA_REGISTRYINDEX, *Ref);
+            lua_setmetatable(L, -2);
+            return true;
+        }
+
+        const auto MetatableName = LowLevel::GetMetatableName(Type);
+        if (!PushMetatable(L, TCHAR_TO_UTF8(*MetatableName)))
+            return false;
+
+        lua_pushvalue(L, -1);
+        MetatableRefs.Add(Type, luaL_ref(L, LUA_REGISTRYINDEX));
+        lua_setmetatable(L, -2);
+        return true;
+    }
+
     FClassDesc* FClassRegistry::Register(const char* MetatableName)
     {
         const auto L = Env->GetMainState();
@@ -317,6 +367,24 @@ namespace UnLua
         }
         const auto L = Env->GetMainState();
         const auto MetatableName = ClassDesc->GetName();
+
+        // drop the cached references of the unregistered metatable
+        if (luaL_getmetatable(L, TCHAR_TO_UTF8(*MetatableName)) == LUA_TTABLE)
+        {
+            for (auto It = MetatableRefs.CreateIterator(); It; ++It)
+            {
+                lua_rawgeti(L, LUA_REGISTRYINDEX, It.Value());
+                const bool bSame = lua_rawequal(L, -1, -2) != 0;
+                lua_pop(L, 1);
+                if (bSame)
+                {
+                    luaL_unref(L, LUA_REGISTRYINDEX, It.Value());
+                    It.RemoveCurrent();
+                }
+            }
+        }
+        lua_pop(L, 1);
+
         lua_pushnil(L);
         lua_setfield(L, LUA_REGISTRYINDEX, TCHAR_TO_UTF8(*MetatableName));
     }
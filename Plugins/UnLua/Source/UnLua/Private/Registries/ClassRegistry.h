@@ -26,6 +26,8 @@ namespace UnLua
     public:
         explicit FClassRegistry(FLuaEnv* Env);
 
+        void NotifyUObjectsDeleted(const TArray<UObject*>& Objects);
+
         static FClassRegistry* Find(const lua_State* L);
 
         static FClassDesc* Find(const char* TypeName);
@@ -46,6 +48,12 @@ namespace UnLua
 
         bool TrySetMetatable(lua_State* L, const char* MetatableName);
 
+        /**
+         * Set the metatable of the type to the value on top of the stack. Metatables are cached by registry
+         * references, so there is no name building or string lookup for known types.
+         */
+        bool TrySetMetatable(lua_State* L, const UStruct* Type);
+
         FClassDesc* Register(const char* MetatableName);
 
         FClassDesc* Register(const UStruct* Class);
@@ -59,5 +67,6 @@ namespace UnLua
         static TMap<FName, FClassDesc*> Name2Classes;
 
         FLuaEnv* Env;
+        TMap<const UStruct*, int32> MetatableRefs;
     };
 }
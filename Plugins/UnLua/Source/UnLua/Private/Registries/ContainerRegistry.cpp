@@ -27,7 +27,7 @@ namespace UnLua
         lua_pushstring(L, "ScriptContainerMap");
         LowLevel::CreateWeakValueTable(L);
         lua_pushvalue(L, -1);
-        MapRef = luaL_ref(L, -1);
+        MapRef = luaL_ref(L, LUA_REGISTRYINDEX);
         lua_rawset(L, LUA_REGISTRYINDEX);
     }
 
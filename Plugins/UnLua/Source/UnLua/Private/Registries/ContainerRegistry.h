@@ -46,7 +46,12 @@ namespace UnLua
         void Remove(const FLuaSet* Container);
 
         void Remove(const FLuaMap* Container);
-        
+
+        /**
+         * Get the registry reference of the weak table which caches script containers ('ScriptContainerMap')
+         */
+        FORCEINLINE int GetMapRef() const { return MapRef; }
+
     private:
         static void* NewUserdata(lua_State* L, const FScriptContainerDesc& Desc);
 
@@ -1,31 +1,100 @@
 ﻿#include "FunctionRegistry.h"
 #include "lua.hpp"
 #include "LuaEnv.h"
+#include "UnLuaModule.h"
 
 namespace UnLua
 {
+    TMap<UObject*, TMap<ULuaFunction*, FFunctionRegistry::FDispatchEntry>> FFunctionRegistry::DispatchCache;
+    uint32 FFunctionRegistry::DispatchGeneration = 0;
+    uint32 FFunctionRegistry::DispatchCacheGeneration = 0;
+
     FFunctionRegistry::FFunctionRegistry(FLuaEnv* Env)
         : Env(Env)
     {
     }
 
-    void FFunctionRegistry::NotifyUObjectDeleted(UObject* Object)
+    void FFunctionRegistry::NotifyUObjectsDeleted(const TArray<UObject*>& Objects)
+    {
+        if (LuaFunctions.Num() == 0)
+            return;
+
+        const auto L = Env->GetMainState();
+        for (const auto Object : Objects)
+        {
+            FFunctionInfo Info;
+            if (LuaFunctions.RemoveAndCopyValue((ULuaFunction*)Object, Info))
+            {
+                luaL_unref(L, LUA_REGISTRYINDEX, Info.LuaRef);
+                InvalidateDispatchCache();
+            }
+        }
+    }
+
+    void FFunctionRegistry::Dispatch(ULuaFunction* Function, UObject* Context, FFrame& Stack, RESULT_DECL)
     {
-        const auto Function = (ULuaFunction*)Object;
-        const auto Info = LuaFunctions.Find(Function);
-        if (!Info)
+        if (DispatchCacheGeneration != DispatchGeneration)
+        {
+            DispatchCache.Reset();
+            DispatchCacheGeneration = DispatchGeneration;
+        }
+
+        const auto Functions = DispatchCache.Find(Context);
+        const auto Cached = Functions ? Functions->Find(Function) : nullptr;
+        if (Cached)
+        {
+            const auto Entry = *Cached;
+            Entry.Env->FlushDeletedObjects();
+            // flushing may unbind the object or delete the function
+            if (DispatchCacheGeneration == DispatchGeneration && DispatchCache.Contains(Context))
+            {
+                Entry.Desc->CallLua(Entry.Env->GetMainState(), Entry.FuncRef, Entry.SelfRef, Stack, RESULT_PARAM);
+                return;
+            }
+        }
+
+        const auto Env = IUnLuaModule::Get().GetEnv(Context);
+        if (!Env)
+        {
+            // PIE 结束时可能已经没有Lua环境了
+            return;
+        }
+
+        FDispatchEntry Entry;
+        if (!Env->GetFunctionRegistry()->Resolve(Function, Context, Entry))
+        {
+            InvokeOverridden(Function, Context, Stack, RESULT_PARAM);
             return;
-        luaL_unref(Env->GetMainState(), LUA_REGISTRYINDEX, Info->LuaRef);
-        LuaFunctions.Remove(Function);
+        }
+
+        if (DispatchCacheGeneration != DispatchGeneration)
+        {
+            DispatchCache.Reset();
+            DispatchCacheGeneration = DispatchGeneration;
+        }
+        DispatchCache.FindOrAdd(Context).Add(Function, Entry);
+        Entry.Desc->CallLua(Env->GetMainState(), Entry.FuncRef, Entry.SelfRef, Stack, RESULT_PARAM);
+    }
+
+    void FFunctionRegistry::InvokeOverridden(ULuaFunction* Function, UObject* Context, FFrame& Stack, RESULT_DECL)
+    {
+        // 可能因为Lua模块加载失败导致找不到对应的function，转发给原函数
+        const auto Overridden = Function->GetOverridden();
+        if (Overridden && Stack.Code)
+            Overridden->Invoke(Context, Stack, RESULT_PARAM);
     }
 
-    void FFunctionRegistry::Invoke(ULuaFunction* Function, UObject* Context, FFrame& Stack, RESULT_DECL)
+    bool FFunctionRegistry::Resolve(ULuaFunction* Function, UObject* Context, FDispatchEntry& OutEntry)
     {
+        Env->FlushDeletedObjects();
+
         // TODO: refactor
-        if (UNLIKELY(!Env->GetObjectRegistry()->IsBound(Context)))
+        int32 SelfRef;
+        if (UNLIKELY(!Env->GetObjectRegistry()->TryGetBoundRef(Context, SelfRef)))
+        {
             Env->TryBind(Context);
-
-        const auto SelfRef = Env->GetObjectRegistry()->GetBoundRef(Context);
+            SelfRef = Env->GetObjectRegistry()->GetBoundRef(Context);
+        }
         check(SelfRef!=LUA_NOREF);
 
         const auto L = Env->GetMainState();
@@ -73,13 +142,12 @@ namespace UnLua
         }
 
         if (FuncRef == LUA_NOREF)
-        {
-            // 可能因为Lua模块加载失败导致找不到对应的function，转发给原函数
-            const auto Overridden = Function->GetOverridden();
-            if (Overridden && Stack.Code)
-                Overridden->Invoke(Context, Stack, RESULT_PARAM);
-            return;
-        }
-        FuncDesc->CallLua(L, FuncRef, SelfRef, Stack, RESULT_PARAM);
+            return false;
+
+        OutEntry.Env = Env;
+        OutEntry.SelfRef = SelfRef;
+        OutEntry.FuncRef = FuncRef;
+        OutEntry.Desc = FuncDesc;
+        return true;
     }
 }
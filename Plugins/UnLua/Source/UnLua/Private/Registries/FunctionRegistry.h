@@ -27,9 +27,29 @@ namespace UnLua
     public:
         explicit FFunctionRegistry(FLuaEnv* Env);
 
-        void NotifyUObjectDeleted(UObject* Object);
-        
-        void Invoke(ULuaFunction* Function, UObject* Context, FFrame& Stack, RESULT_DECL);
+        void NotifyUObjectsDeleted(const TArray<UObject*>& Objects);
+
+        /**
+         * 蓝图调用Lua的入口，按(对象, 函数)缓存已经解析好的Lua环境、self引用和Lua函数引用，
+         * 命中时不再需要定位Lua环境和查找绑定关系
+         */
+        static void Dispatch(ULuaFunction* Function, UObject* Context, FFrame& Stack, RESULT_DECL);
+
+        /**
+         * 使所有缓存的调用入口失效，在函数删除以及Lua环境销毁时调用
+         */
+        FORCEINLINE static void InvalidateDispatchCache()
+        {
+            ++DispatchGeneration;
+        }
+
+        /**
+         * 使指定对象缓存的调用入口失效，在对象解绑时调用
+         */
+        FORCEINLINE static void InvalidateDispatchCache(UObject* Object)
+        {
+            DispatchCache.Remove(Object);
+        }
 
     private:
         struct FFunctionInfo
@@ -38,7 +58,23 @@ namespace UnLua
             TUniquePtr<FFunctionDesc> Desc;
         };
 
+        struct FDispatchEntry
+        {
+            FLuaEnv* Env;
+            int32 SelfRef;
+            lua_Integer FuncRef;
+            FFunctionDesc* Desc;
+        };
+
+        bool Resolve(ULuaFunction* Function, UObject* Context, FDispatchEntry& OutEntry);
+
+        static void InvokeOverridden(ULuaFunction* Function, UObject* Context, FFrame& Stack, RESULT_DECL);
+
         FLuaEnv* Env;
         TMap<ULuaFunction*, FFunctionInfo> LuaFunctions;
+
+        static TMap<UObject*, TMap<ULuaFunction*, FDispatchEntry>> DispatchCache;
+        static uint32 DispatchGeneration;
+        static uint32 DispatchCacheGeneration;
     };
 }
@@ -16,6 +16,7 @@
 #include "LowLevel.h"
 #include "LuaEnv.h"
 #include "UnLuaDelegates.h"
+#include "UnLuaSettings.h"
 
 namespace UnLua
 {
@@ -47,10 +48,14 @@ namespace UnLua
     FObjectRegistry::FObjectRegistry(FLuaEnv* Env)
         : Env(Env)
     {
+        bLazyInstanceTables = GetDefault<UUnLuaSettings>()->bLazyInstanceTables;
+
         const auto L = Env->GetMainState();
 
         lua_pushstring(L, REGISTRY_KEY);
         LowLevel::CreateWeakValueTable(L);
+        lua_pushvalue(L, -1);
+        ObjectMapRef = luaL_ref(L, LUA_REGISTRYINDEX);
         lua_rawset(L, LUA_REGISTRYINDEX);
 
         lua_pushstring(L, MANUAL_REF_PROXY_MAP);
@@ -88,7 +93,10 @@ namespace UnLua
             return;
         }
 
-        lua_getfield(L, LUA_REGISTRYINDEX, REGISTRY_KEY);
+        if (UNLIKELY(FindRef(Object) == LazyRef))
+            CreateInstance(Object);
+
+        lua_rawgeti(L, LUA_REGISTRYINDEX, ObjectMapRef);
         lua_pushlightuserdata(L, Object);
         const auto Type = lua_rawget(L, -2);
         if (Type == LUA_TNIL)
@@ -98,24 +106,41 @@ namespace UnLua
             lua_pushlightuserdata(L, Object);
             lua_pushvalue(L, -2);
             lua_rawset(L, -4);
-            ObjectRefs.Add(Object, LUA_NOREF);
+            SetRef(Object, LUA_NOREF);
         }
         lua_remove(L, -2);
     }
 
     int FObjectRegistry::Bind(UObject* Object)
     {
-        if (const auto Exists = ObjectRefs.Find(Object))
-        {
-            if (*Exists != LUA_NOREF)
-                return *Exists;
-        }
+        const int32 Exists = FindRef(Object);
+        if (Exists > 0)
+            return Exists;
+        return CreateInstance(Object);
+    }
+
+    bool FObjectRegistry::BindLazy(UObject* Object)
+    {
+        if (!bLazyInstanceTables)
+            return false;
+
+        const int32 Exists = FindRef(Object);
+        if (Exists == LazyRef || Exists > 0)
+            return true;
+        if (Exists == LUA_NOREF)
+            return false;
+
+        SetRef(Object, LazyRef);
+        return true;
+    }
 
+    int FObjectRegistry::CreateInstance(UObject* Object)
+    {
         const auto L = Env->GetMainState();
 
         int OldTop = lua_gettop(L);
 
-        lua_getfield(L, LUA_REGISTRYINDEX, REGISTRY_KEY);
+        lua_rawgeti(L, LUA_REGISTRYINDEX, ObjectMapRef);
         lua_pushlightuserdata(L, Object);
         lua_newtable(L); // create a Lua table ('INSTANCE')
         PushObjectCore(L, Object); // push UObject ('RAW_UOBJECT')
@@ -132,6 +157,8 @@ namespace UnLua
         if (TypeModule != LUA_TTABLE || TypeMetatable == LUA_TNIL)
         {
             lua_pop(L, lua_gettop(L) - OldTop);
+            if (FindRef(Object) == LazyRef)
+                SetRef(Object, 0);
             return LUA_REFNIL;
         }
 
@@ -146,7 +173,7 @@ namespace UnLua
 
         lua_pushvalue(L, -1);
         const auto Ret = luaL_ref(L, LUA_REGISTRYINDEX);
-        ObjectRefs.Add(Object, Ret);
+        SetRef(Object, Ret);
 
         FUnLuaDelegates::OnObjectBinded.Broadcast(Object); // 'INSTANCE' is on the top of stack now
 
@@ -157,22 +184,25 @@ namespace UnLua
 
     bool FObjectRegistry::IsBound(const UObject* Object) const
     {
-        const auto Exists = ObjectRefs.Find(Object);
-        return Exists && *Exists != LUA_NOREF;
+        const int32 Ref = FindRef(Object);
+        return Ref > 0 || Ref == LazyRef;
     }
 
-    int FObjectRegistry::GetBoundRef(const UObject* Object) const
+    int FObjectRegistry::GetBoundRef(UObject* Object)
     {
-        const auto Ref = ObjectRefs.Find(Object);
-        if (Ref)
-            return *Ref;
-        return LUA_NOREF;
+        int32 Ref;
+        return TryGetBoundRef(Object, Ref) ? Ref : LUA_NOREF;
     }
 
     void FObjectRegistry::Unbind(UObject* Object)
     {
-        int32 Ref;
-        if (!ObjectRefs.RemoveAndCopyValue(Object, Ref))
+        const int32 Ref = FindRef(Object);
+        if (Ref == 0)
+            return;
+        SetRef(Object, 0);
+
+        // table was never created
+        if (Ref == LazyRef)
             return;
 
         const auto L = Env->GetMainState();
@@ -197,6 +227,7 @@ namespace UnLua
 
         check(lua_istable(L, -1));
         luaL_unref(L, LUA_REGISTRYINDEX, Ref);
+        FFunctionRegistry::InvalidateDispatchCache(Object);
         FUnLuaDelegates::OnObjectUnbinded.Broadcast(Object); // object instance ('INSTANCE') is on the top of stack now
 
         lua_pushstring(L, "Object");
@@ -238,10 +269,22 @@ namespace UnLua
         Env->RemoveManualObjectReference(Object);
     }
 
+    void FObjectRegistry::SetRef(const UObject* Object, int32 Ref)
+    {
+        const int32 Index = GUObjectArray.ObjectToIndex(Object);
+        if (Index >= ObjectRefs.Num())
+        {
+            if (Ref == 0)
+                return;
+            ObjectRefs.SetNumZeroed(FMath::Max(Index + 1, GUObjectArray.GetObjectArrayNum()));
+        }
+        ObjectRefs[Index] = Ref;
+    }
+
     void FObjectRegistry::RemoveFromObjectMapAndPushToStack(UObject* Object)
     {
         const auto L = Env->GetMainState();
-        lua_getfield(L, LUA_REGISTRYINDEX, REGISTRY_KEY);
+        lua_rawgeti(L, LUA_REGISTRYINDEX, ObjectMapRef);
         lua_pushlightuserdata(L, Object);
         lua_rawget(L, -2);
         lua_pushlightuserdata(L, Object);
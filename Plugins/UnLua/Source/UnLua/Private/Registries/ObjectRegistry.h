@@ -44,22 +44,48 @@ namespace UnLua
         template <typename T>
         FORCEINLINE TSharedPtr<T> Get(lua_State* L, int Index);
 
+        /**
+         * 获取栈上TSharedPtr所持有的裸指针，不增加引用计数。
+         * 指针的生命周期由该userdata保证，适用于闭包upvalue等热点路径。
+         */
+        template <typename T>
+        static FORCEINLINE T* GetRaw(lua_State* L, int Index);
+
         /**
          * 将一个UObject绑定到Lua环境，作为lua table访问。
          * @return lua引用ID
          */
         int Bind(UObject* Object);
 
+        /**
+         * 延迟绑定一个UObject，只记录绑定关系，Lua里的table在第一次被访问时才创建。
+         * 未开启延迟绑定或者对象已经在Lua里存在时不会延迟。
+         * @return 是否已经延迟绑定，返回false时需要调用Bind立即绑定
+         */
+        bool BindLazy(UObject* Object);
+
         /**
          * 获取一个值，表示UObject是否绑定到了Lua环境。
          */
         bool IsBound(const UObject* Object) const;
 
         /**
-         * 获取指定UObject在Lua里绑定的table的引用ID。
+         * 获取指定UObject在Lua里绑定的table的引用ID，延迟绑定的对象会在这里创建table。
          * @return 若没有绑定过则返回LUA_NOREF。
          */
-        int GetBoundRef(const UObject* Object) const;
+        int GetBoundRef(UObject* Object);
+
+        /**
+         * 尝试获取指定UObject在Lua里绑定的table的引用ID，只需一次查找。
+         * @return 若没有绑定过则返回false。
+         */
+        FORCEINLINE bool TryGetBoundRef(UObject* Object, int32& OutRef)
+        {
+            OutRef = FindRef(Object);
+            if (UNLIKELY(OutRef == LazyRef))
+                OutRef = CreateInstance(Object);
+            return OutRef > 0;
+        }
 
         /**
          * 将指定的UObject从Lua环境解绑。
@@ -76,11 +102,39 @@ namespace UnLua
          */
         void RemoveManualRef(UObject* Object);
 
+        /**
+         * 获取UObject映射表（弱表）的lua引用ID，避免按字符串查找注册表。
+         */
+        FORCEINLINE int32 GetObjectMapRef() const { return ObjectMapRef; }
+
     private:
+        /** 延迟绑定但还没有创建table的对象的引用记录 */
+        static constexpr int32 LazyRef = MIN_int32;
+
+        /**
+         * 为UObject创建Lua里的table并记录引用。
+         * @return lua引用ID，失败时返回LUA_REFNIL
+         */
+        int CreateInstance(UObject* Object);
+
         void RemoveFromObjectMapAndPushToStack(UObject* Object);
 
+        /**
+         * 以GUObjectArray中的索引查找UObject对应的引用记录。
+         * @return 0表示未记录，LUA_NOREF表示已压栈但未绑定，LazyRef表示延迟绑定，否则为绑定的table引用ID。
+         */
+        FORCEINLINE int32 FindRef(const UObject* Object) const
+        {
+            const int32 Index = GUObjectArray.ObjectToIndex(Object);
+            return ObjectRefs.IsValidIndex(Index) ? ObjectRefs[Index] : 0;
+        }
+
+        void SetRef(const UObject* Object, int32 Ref);
+
         FLuaEnv* Env;
-        TMap<UObject*, int32> ObjectRefs;
+        bool bLazyInstanceTables;
+        int32 ObjectMapRef;
+        TArray<int32> ObjectRefs; // 以GUObjectArray索引寻址的平坦数组，避免对大量存活对象做哈希查找
     };
 
     template <typename T>
@@ -98,4 +152,11 @@ namespace UnLua
         const auto Ptr = lua_touserdata(L, Index);
         return *static_cast<TSharedPtr<T>*>(Ptr);
     }
+
+    template <typename T>
+    T* FObjectRegistry::GetRaw(lua_State* L, int Index)
+    {
+        const auto Ptr = lua_touserdata(L, Index);
+        return static_cast<TSharedPtr<T>*>(Ptr)->Get();
+    }
 }
@@ -15,9 +15,13 @@ namespace UnLua
         check(PropertyCollector);
     }
 
-    void FPropertyRegistry::NotifyUObjectDeleted(UObject* Object)
+    void FPropertyRegistry::NotifyUObjectsDeleted(const TArray<UObject*>& Objects)
     {
-        FieldProperties.Remove(static_cast<UField*>(Object));
+        if (FieldProperties.Num() == 0)
+            return;
+
+        for (const auto Object : Objects)
+            FieldProperties.Remove(static_cast<UField*>(Object));
     }
 
     TSharedPtr<ITypeInterface> FPropertyRegistry::CreateTypeInterface(lua_State* L, int32 Index)
@@ -255,6 +259,8 @@ namespace UnLua
 
     TSharedPtr<ITypeInterface> FPropertyRegistry::GetFieldProperty(UField* Field)
     {
+        Env->FlushDeletedObjects();
+
         if (const auto Exists = FieldProperties.Find(Field))
             return *Exists;
 
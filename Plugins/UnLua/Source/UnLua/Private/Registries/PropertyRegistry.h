@@ -32,7 +32,7 @@ namespace UnLua
     public:
         explicit FPropertyRegistry(FLuaEnv* Env);
 
-        void NotifyUObjectDeleted(UObject* Object);
+        void NotifyUObjectsDeleted(const TArray<UObject*>& Objects);
 
         /**
          * Create a type interface according to Lua parameter's type
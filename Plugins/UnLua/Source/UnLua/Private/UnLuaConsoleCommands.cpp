@@ -20,6 +20,11 @@ namespace UnLua
               *LOCTEXT("CommandText_CollectGarbage", "Force collect garbage in lua env.").ToString(),
               FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::CollectGarbage)
           ),
+          BudgetReportCommand(
+              TEXT("lua.budget"),
+              *LOCTEXT("CommandText_BudgetReport", "Print call sites exceeding script budgets in lua env, 'lua.budget reset' to clear them.").ToString(),
+              FConsoleCommandWithArgsDelegate::CreateRaw(this, &FUnLuaConsoleCommands::BudgetReport)
+          ),
           Module(InModule)
     {
     }
@@ -79,6 +84,22 @@ namespace UnLua
 
         Env->GC();
     }
+
+    void FUnLuaConsoleCommands::BudgetReport(const TArray<FString>& Args) const
+    {
+        auto Env = Module->GetEnv();
+        if (!Env)
+        {
+            UE_LOG(LogUnLua, Warning, TEXT("no available lua env found to report script budgets."));
+            return;
+        }
+
+        const auto DeadLoopCheck = Env->GetDeadLoopCheck();
+        if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+            DeadLoopCheck->ResetReports();
+        else
+            DeadLoopCheck->DumpReports();
+    }
 }
 
 #undef LOCTEXT_NAMESPACE
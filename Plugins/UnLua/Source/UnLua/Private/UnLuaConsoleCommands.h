@@ -27,6 +27,8 @@ namespace UnLua
 
         FAutoConsoleCommand CollectGarbageCommand;
 
+        FAutoConsoleCommand BudgetReportCommand;
+
         explicit FUnLuaConsoleCommands(IUnLuaModule* InModule);
 
         void Do(const TArray<FString>& Args) const;
@@ -35,6 +37,8 @@ namespace UnLua
 
         void CollectGarbage(const TArray<FString>& Args) const;
 
+        void BudgetReport(const TArray<FString>& Args) const;
+
     private:
         IUnLuaModule* Module;
     };
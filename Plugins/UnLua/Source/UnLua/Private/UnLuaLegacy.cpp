@@ -17,7 +17,7 @@
 
 UNLUA_DEFINE_STAT(Lua_Memory);
 UNLUA_DEFINE_STAT(PersistentParamBuffer_Memory);
-UNLUA_DEFINE_STAT(OutParmRec_Memory);
+UNLUA_DEFINE_STAT(ParamArenaHighWater_Memory);
 UNLUA_DEFINE_STAT(ContainerElementCache_Memory);
 
 namespace UnLua
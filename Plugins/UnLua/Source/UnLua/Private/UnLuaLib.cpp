@@ -2,12 +2,14 @@
 #include "LowLevel.h"
 #include "LuaEnv.h"
 #include "UnLuaBase.h"
+#include "ReflectionUtils/PropertyAccessor.h"
 
 namespace UnLua
 {
     namespace UnLuaLib
     {
         static const char* PACKAGE_PATH_KEY = "PackagePath";
+        static const char* FIELD_TAG_CACHE_KEY = "UnLua_LegacyFieldTags";
 
         static FString GetMessage(lua_State* L)
         {
@@ -51,10 +53,16 @@ namespace UnLua
         static int HotReload(lua_State* L)
         {
 #if UNLUA_WITH_HOT_RELOAD
+            // files may be added or removed since last search
+            FLuaEnv::FindEnvChecked(L).GetModulePreloader()->ClearResolvedPaths();
             if (luaL_dostring(L, "require('UnLua.HotReload').reload()") != 0)
             {
                 LogError(L);
             }
+
+            // reflected fields of classes may change after reloading
+            LowLevel::CreateWeakKeyTable(L);
+            lua_setfield(L, LUA_REGISTRYINDEX, FIELD_TAG_CACHE_KEY);
 #endif
             return 0;
         }
@@ -93,13 +101,26 @@ namespace UnLua
 
 #pragma region Legacy Support
 
-        int32 GetUProperty(lua_State* L)
+        static int32 ReadUProperty(lua_State* L, int32 PropertyIndex)
         {
-            auto Ptr = lua_touserdata(L, 2);
-            if (!Ptr)
-                return 0;
+            const auto Accessor = FPropertyAccessor::Get(L, PropertyIndex);
+            if (Accessor && Accessor->IsValid())
+            {
+                auto Self = GetCppInstance(L, 1);
+                if (!Self)
+                    return 0;
+
+                if (LowLevel::IsReleasedPtr(Self))
+                    return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to read property '%s' on released object"), *Accessor->Desc->GetName())));
 
-            auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(Ptr);
+                if (!Accessor->CheckOwner(L, Self))
+                    return 0;
+
+                Accessor->Read(L, Self);
+                return 1;
+            }
+
+            auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(lua_touserdata(L, PropertyIndex));
             if (!Property->IsValid())
                 return 0;
 
@@ -117,13 +138,23 @@ namespace UnLua
             return 1;
         }
 
-        int32 SetUProperty(lua_State* L)
+        static int32 WriteUProperty(lua_State* L, int32 PropertyIndex)
         {
-            auto Ptr = lua_touserdata(L, 2);
-            if (!Ptr)
+            const auto Accessor = FPropertyAccessor::Get(L, PropertyIndex);
+            if (Accessor && Accessor->IsValid())
+            {
+                auto Self = GetCppInstance(L, 1);
+                if (LowLevel::IsReleasedPtr(Self))
+                    return luaL_error(L, TCHAR_TO_UTF8(*FString::Printf(TEXT("attempt to write property '%s' on released object"), *Accessor->Desc->GetName())));
+
+                if (!Self || !Accessor->CheckOwner(L, Self))
+                    return 0;
+
+                Accessor->Write(L, Self, 3);
                 return 0;
+            }
 
-            auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(Ptr);
+            auto Property = static_cast<TSharedPtr<UnLua::ITypeOps>*>(lua_touserdata(L, PropertyIndex));
             if (!Property->IsValid())
                 return 0;
 
@@ -138,63 +169,161 @@ namespace UnLua
             return 0;
         }
 
+        int32 GetUProperty(lua_State* L)
+        {
+            if (!lua_touserdata(L, 2))
+                return 0;
+            return ReadUProperty(L, 2);
+        }
+
+        int32 SetUProperty(lua_State* L)
+        {
+            if (!lua_touserdata(L, 2))
+                return 0;
+            return WriteUProperty(L, 2);
+        }
+
+        /* 标记在模块及其Super链中都不存在、也不是反射字段的key */
+        static int NotExistTag;
+
+        /* 标记反射字段（UProperty/UFunction），需要到UClass元表中查找 */
+        static int ReflectedTag;
+
+        /**
+         * 获取模块的反射字段标记表，只记录在模块及其Super链中找不到的key，模块中的函数每次都从Super链中查找
+         */
+        static void PushFieldTagTable(lua_State* L, int32 ModuleIndex)
+        {
+            ModuleIndex = lua_absindex(L, ModuleIndex);
+            if (lua_getfield(L, LUA_REGISTRYINDEX, FIELD_TAG_CACHE_KEY) != LUA_TTABLE)
+            {
+                lua_pop(L, 1);
+                LowLevel::CreateWeakKeyTable(L);
+                lua_pushvalue(L, -1);
+                lua_setfield(L, LUA_REGISTRYINDEX, FIELD_TAG_CACHE_KEY);
+            }
+
+            lua_pushvalue(L, ModuleIndex);
+            if (lua_rawget(L, -2) == LUA_TTABLE)
+            {
+                lua_remove(L, -2);
+                return;
+            }
+            lua_pop(L, 1);
+
+            lua_newtable(L);
+            lua_pushvalue(L, ModuleIndex);
+            lua_pushvalue(L, -2);
+            lua_rawset(L, -4);
+            lua_remove(L, -2);
+        }
+
+        /**
+         * __index of instances, Index(t, k)
+         */
+        static int32 Index(lua_State* L)
+        {
+            if (!lua_getmetatable(L, 1))
+                return 0;
+            const int32 ModuleIndex = lua_gettop(L);
+
+            // functions may be assigned or replaced on the module or any Super at runtime, never snapshot them
+            lua_pushvalue(L, ModuleIndex);
+            while (lua_type(L, -1) == LUA_TTABLE)
+            {
+                lua_pushvalue(L, 2);
+                if (lua_rawget(L, -2) != LUA_TNIL)
+                {
+                    lua_pushvalue(L, 2);
+                    lua_pushvalue(L, -2);
+                    lua_rawset(L, 1);
+                    return 1;
+                }
+                lua_pop(L, 1);
+                lua_pushstring(L, "Super");
+                lua_rawget(L, -2);
+                lua_remove(L, -2);
+            }
+            lua_pop(L, 1);
+
+            PushFieldTagTable(L, ModuleIndex);
+            const int32 TagsIndex = lua_gettop(L);
+            lua_pushvalue(L, 2);
+            const void* Tag = lua_rawget(L, TagsIndex) == LUA_TLIGHTUSERDATA ? lua_touserdata(L, -1) : nullptr;
+            lua_pop(L, 1);
+            if (Tag == &NotExistTag)
+                return 0;
+
+            // reflected fields are cached in the metatable of UClass
+            lua_pushvalue(L, 2);
+            const int32 FieldType = lua_gettable(L, ModuleIndex);
+            if (Tag == nullptr)
+            {
+                lua_pushvalue(L, 2);
+                lua_pushlightuserdata(L, FieldType == LUA_TNIL ? &NotExistTag : &ReflectedTag);
+                lua_rawset(L, TagsIndex);
+            }
+
+            if (FieldType == LUA_TUSERDATA)
+                return ReadUProperty(L, lua_gettop(L));
+
+            if (FieldType == LUA_TFUNCTION)
+            {
+                lua_pushvalue(L, 2);
+                lua_pushvalue(L, -2);
+                lua_rawset(L, 1);
+            }
+            return 1;
+        }
+
+        /**
+         * __newindex of instances, NewIndex(t, k, v)
+         */
+        static int32 NewIndex(lua_State* L)
+        {
+            if (lua_getmetatable(L, 1))
+            {
+                lua_pushvalue(L, 2);
+                if (lua_rawget(L, -2) == LUA_TNIL)
+                {
+                    lua_pop(L, 1);
+                    PushFieldTagTable(L, -1);
+                    lua_pushvalue(L, 2);
+                    lua_rawget(L, -2);
+                    const bool bNotExist = lua_touserdata(L, -1) == &NotExistTag;
+                    lua_pop(L, 2);
+
+                    if (!bNotExist)
+                    {
+                        lua_pushvalue(L, 2);
+                        if (lua_gettable(L, -2) == LUA_TUSERDATA)
+                            return WriteUProperty(L, lua_gettop(L));
+                    }
+                }
+            }
+
+            lua_settop(L, 3);
+            lua_rawset(L, 1);
+            return 0;
+        }
+
         static constexpr luaL_Reg UnLua_LegacyFunctions[] = {
             {"GetUProperty", GetUProperty},
             {"SetUProperty", SetUProperty},
+            {"Index", Index},
+            {"NewIndex", NewIndex},
             {NULL, NULL}
         };
 
         static void LegacySupport(lua_State* L)
         {
             static const char* Chunk = R"(
-            local rawget = _G.rawget
-            local rawset = _G.rawset
-            local rawequal = _G.rawequal
-            local type = _G.type
-            local getmetatable = _G.getmetatable
             local require = _G.require
 
             local GetUProperty = GetUProperty
             local SetUProperty = SetUProperty
-
-            local NotExist = {}
-
-            local function Index(t, k)
-                local mt = getmetatable(t)
-                local super = mt
-                while super do
-                    local v = rawget(super, k)
-                    if v ~= nil and not rawequal(v, NotExist) then
-                        rawset(t, k, v)
-                        return v
-                    end
-                    super = rawget(super, "Super")
-                end
-
-                local p = mt[k]
-                if p ~= nil then
-                    if type(p) == "userdata" then
-                        return GetUProperty(t, p)
-                    elseif type(p) == "function" then
-                        rawset(t, k, p)
-                    elseif rawequal(p, NotExist) then
-                        return nil
-                    end
-                else
-                    rawset(mt, k, NotExist)
-                end
-
-                return p
-            end
-
-            local function NewIndex(t, k, v)
-                local mt = getmetatable(t)
-                local p = mt[k]
-                if type(p) == "userdata" then
-                    return SetUProperty(t, p, v)
-                end
-                rawset(t, k, v)
-            end
+            local Index = Index
+            local NewIndex = NewIndex
 
             local function Class(super_name)
                 local super_class = nil
@@ -58,6 +58,15 @@ bool UUnLuaManager::Bind(UObject *Object, const TCHAR *InModuleName, int32 Initi
     check(Object);
 
     const auto Class = Object->IsA<UClass>() ? static_cast<UClass*>(Object) : Object->GetClass();
+
+    // a deleted class may share the address with this one
+    Env->FlushDeletedObjects();
+
+    // class already bound to the same module, only the instance needs to be created
+    const auto Bound = Classes.Find(Class);
+    if (Bound && Bound->ModuleName == InModuleName)
+        return BindInstance(Object, Class, *Bound, InitializerTableRef);
+
     lua_State *L = Env->GetMainState();
 
     if (!Env->GetClassRegistry()->Register(Class))
@@ -89,43 +98,102 @@ bool UUnLuaManager::Bind(UObject *Object, const TCHAR *InModuleName, int32 Initi
         return false;
     }
 
+    const auto BindInfo = Classes.Find(Class);
+    if (BindInfo)
+        return BindInstance(Object, Class, *BindInfo, InitializerTableRef);
+
     // create a Lua instance for this UObject
     Env->GetObjectRegistry()->Bind(Class);
     Env->GetObjectRegistry()->Bind(Object);
+    return true;
+}
 
-    // try call user first user function handler
-    int32 FunctionRef = PushFunction(L, Object, "Initialize");                  // push hard coded Lua function 'Initialize'
-    if (FunctionRef != LUA_NOREF)
+/**
+ * Push 'Initialize' of the module or its 'Super' chain if it's defined
+ */
+static bool PushInitializeFunction(lua_State* L, const FString& ModuleName, int32 TableRef)
+{
+    // the module is patched in place by hot reload, while the bound table is a copy made at binding
+    if (UnLua::LowLevel::GetLoadedModule(L, TCHAR_TO_UTF8(*ModuleName)) != LUA_TTABLE)
     {
-        if (InitializerTableRef != LUA_NOREF)
-        {
-            lua_rawgeti(L, LUA_REGISTRYINDEX, InitializerTableRef);             // push a initializer table if necessary
-        }
-        else
-        {
-            lua_pushnil(L);
-        }
-        bool bResult = ::CallFunction(L, 2, 0);                                 // call 'Initialize'
-        if (!bResult)
+        lua_pop(L, 1);
+        lua_rawgeti(L, LUA_REGISTRYINDEX, TableRef);
+    }
+
+    while (lua_istable(L, -1))
+    {
+        lua_pushstring(L, "Initialize");
+        lua_rawget(L, -2);
+        if (lua_isfunction(L, -1))
         {
-            UE_LOG(LogUnLua, Warning, TEXT("Failed to call 'Initialize' function!"));
+            lua_remove(L, -2);
+            return true;
         }
-        luaL_unref(L, LUA_REGISTRYINDEX, FunctionRef);
+        lua_pop(L, 1);
+        lua_pushstring(L, "Super");
+        lua_rawget(L, -2);
+        lua_remove(L, -2);
+    }
+    lua_pop(L, 1);
+    return false;
+}
+
+bool UUnLuaManager::BindInstance(UObject *Object, UClass *Class, FClassBindInfo &BindInfo, int32 InitializerTableRef)
+{
+    lua_State *L = Env->GetMainState();
+    const auto ObjectRegistry = Env->GetObjectRegistry();
+    ObjectRegistry->Bind(Class);
+
+    // 'Initialize' is looked up on every bind, as the module may be changed at runtime (e.g. hot reload)
+    const int32 Top = lua_gettop(L);
+    lua_pushcfunction(L, UnLua::ReportLuaCallError);
+    if (!PushInitializeFunction(L, BindInfo.ModuleName, BindInfo.TableRef))
+    {
+        lua_settop(L, Top);
+
+        // create a Lua instance for this UObject, it could be deferred to the first access as there is nothing to initialize
+        if (!ObjectRegistry->BindLazy(Object))
+            ObjectRegistry->Bind(Object);
+        return true;
+    }
+
+    const int32 SelfRef = ObjectRegistry->Bind(Object);
+    if (SelfRef <= 0)
+    {
+        lua_settop(L, Top);
+        return true;
+    }
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, SelfRef);
+    if (InitializerTableRef != LUA_NOREF)
+    {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, InitializerTableRef);                 // push a initializer table if necessary
+    }
+    else
+    {
+        lua_pushnil(L);
+    }
+    bool bResult = ::CallFunction(L, 2, 0);                                     // call 'Initialize'
+    if (!bResult)
+    {
+        UE_LOG(LogUnLua, Warning, TEXT("Failed to call 'Initialize' function!"));
     }
 
     return true;
 }
 
-void UUnLuaManager::NotifyUObjectDeleted(const UObjectBase* Object)
+void UUnLuaManager::NotifyUObjectsDeleted(const TArray<UObject*>& Objects)
 {
-    const UClass* Class = (UClass*)Object;
-    const auto BindInfo = Classes.Find(Class);
-    if (!BindInfo)
+    if (Classes.Num() == 0)
         return;
 
     const auto L = Env->GetMainState();
-    luaL_unref(L, LUA_REGISTRYINDEX, BindInfo->TableRef);
-    Classes.Remove(Class);
+    for (const auto Object : Objects)
+    {
+        FClassBindInfo BindInfo;
+        if (Classes.RemoveAndCopyValue((UClass*)Object, BindInfo))
+            luaL_unref(L, LUA_REGISTRYINDEX, BindInfo.TableRef);
+    }
 }
 
 /**
@@ -139,6 +207,7 @@ void UUnLuaManager::Cleanup()
 
 int UUnLuaManager::GetBoundRef(const UClass* Class)
 {
+    Env->FlushDeletedObjects();
     const auto Info = Classes.Find(Class);
     if (!Info)
         return LUA_NOREF;
@@ -181,19 +250,19 @@ bool UUnLuaManager::ReplaceInputs(AActor *Actor, UInputComponent *InputComponent
     if (!Actor || !InputComponent)
         return false;
 
+    Env->FlushDeletedObjects();
     const auto Class = Actor->GetClass();
     const auto BindInfo = Classes.Find(Class);
     if (!BindInfo)
         return false;
 
-    auto& LuaFunctions = BindInfo->LuaFunctions;
-    ReplaceActionInputs(Actor, InputComponent, LuaFunctions);       // replace action inputs
-    ReplaceKeyInputs(Actor, InputComponent, LuaFunctions);          // replace key inputs
-    ReplaceAxisInputs(Actor, InputComponent, LuaFunctions);         // replace axis inputs
-    ReplaceTouchInputs(Actor, InputComponent, LuaFunctions);        // replace touch inputs
-    ReplaceAxisKeyInputs(Actor, InputComponent, LuaFunctions);      // replace AxisKey inputs
-    ReplaceVectorAxisInputs(Actor, InputComponent, LuaFunctions);   // replace VectorAxis inputs
-    ReplaceGestureInputs(Actor, InputComponent, LuaFunctions);      // replace gesture inputs
+    ReplaceActionInputs(Actor, InputComponent, *BindInfo);          // replace action inputs
+    ReplaceKeyInputs(Actor, InputComponent, *BindInfo);             // replace key inputs
+    ReplaceAxisInputs(Actor, InputComponent, *BindInfo);            // replace axis inputs
+    ReplaceTouchInputs(Actor, InputComponent, *BindInfo);           // replace touch inputs
+    ReplaceAxisKeyInputs(Actor, InputComponent, *BindInfo);         // replace AxisKey inputs
+    ReplaceVectorAxisInputs(Actor, InputComponent, *BindInfo);      // replace VectorAxis inputs
+    ReplaceGestureInputs(Actor, InputComponent, *BindInfo);         // replace gesture inputs
 
     return true;
 }
@@ -295,6 +364,9 @@ bool UUnLuaManager::BindClass(UClass* Class, const FString& InModuleName, FStrin
     UnLua::LowLevel::GetFunctionNames(Env->GetMainState(), Ref, BindInfo.LuaFunctions);
     ULuaFunction::GetOverridableFunctions(Class, BindInfo.UEFunctions);
 
+    if (Class->IsChildOf<AActor>())
+        BuildInputBindInfo(BindInfo);
+
     // 用LuaTable里所有的函数来替换Class上对应的UFunction
     for (const auto& LuaFuncName : BindInfo.LuaFunctions)
     {
@@ -337,12 +409,57 @@ bool UUnLuaManager::BindClass(UClass* Class, const FString& InModuleName, FStrin
     return true;
 }
 
+/**
+ * Parse input functions from the Lua function names of a class, so replacing inputs for its instances
+ * needn't try every action/key/event combination
+ */
+void UUnLuaManager::BuildInputBindInfo(FClassBindInfo &BindInfo)
+{
+    static const FName NAME_Touch = TEXT("Touch");
+
+    for (const FName &FuncName : BindInfo.LuaFunctions)
+    {
+        if (DefaultAxisNames.Contains(FuncName))
+            BindInfo.DefaultAxisInputs.Add(FuncName);
+
+        const FString FuncNameStr = FuncName.ToString();
+        int32 Index;
+        if (!FuncNameStr.FindLastChar(TEXT('_'), Index) || Index == 0)
+            continue;
+
+        const TCHAR *Suffix = *FuncNameStr + Index + 1;
+        int32 KeyEvent = IE_Pressed;
+        while (KeyEvent < IE_Axis && FCString::Stricmp(Suffix, SReadableInputEvent[KeyEvent]) != 0)
+            ++KeyEvent;
+        if (KeyEvent == IE_Axis)
+            continue;
+
+        FInputBindInfo Input;
+        Input.Name = FName(*FuncNameStr.Left(Index));
+        Input.FuncName = FuncName;
+        Input.KeyEvent = (EInputEvent)KeyEvent;
+
+        BindInfo.ActionInputs.Add(Input);
+        if (Input.Name == NAME_Touch)
+            BindInfo.TouchInputs.Add(Input);
+        else if (FKey(Input.Name).IsValid())
+            BindInfo.KeyInputs.Add(Input);
+    }
+}
+
 /**
  * Replace action inputs
  */
-void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
+    if (BindInfo.ActionInputs.Num() == 0)
+        return;
+
     UClass *Class = Actor->GetClass();
+    auto FindInput = [&BindInfo](FName Name, EInputEvent KeyEvent)
+    {
+        return BindInfo.ActionInputs.FindByPredicate([Name, KeyEvent](const FInputBindInfo &Input) { return Input.KeyEvent == KeyEvent && Input.Name == Name; });
+    };
 
     TSet<FName> ActionNames;
     int32 NumActionBindings = InputComponent->GetNumActionBindings();
@@ -350,55 +467,55 @@ void UUnLuaManager::ReplaceActionInputs(AActor *Actor, UInputComponent *InputCom
     {
         FInputActionBinding &IAB = InputComponent->GetActionBinding(i);
         FName Name = GET_INPUT_ACTION_NAME(IAB);
-        FString ActionName = Name.ToString();
         ActionNames.Add(Name);
 
-        FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *ActionName, SReadableInputEvent[IAB.KeyEvent]));
-        if (LuaFunctions.Find(FuncName))
+        if (const FInputBindInfo *Input = FindInput(Name, IAB.KeyEvent))
         {
-            ULuaFunction::Override(InputActionFunc, Class, FuncName);
-            IAB.ActionDelegate.BindDelegate(Actor, FuncName);
+            ULuaFunction::Override(InputActionFunc, Class, Input->FuncName);
+            IAB.ActionDelegate.BindDelegate(Actor, Input->FuncName);
         }
 
         if (!IS_INPUT_ACTION_PAIRED(IAB))
         {
             EInputEvent IE = IAB.KeyEvent == IE_Pressed ? IE_Released : IE_Pressed;
-            FuncName = FName(*FString::Printf(TEXT("%s_%s"), *ActionName, SReadableInputEvent[IE]));
-            if (LuaFunctions.Find(FuncName))
+            if (const FInputBindInfo *Input = FindInput(Name, IE))
             {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
+                ULuaFunction::Override(InputActionFunc, Class, Input->FuncName);
                 FInputActionBinding AB(Name, IE);
-                AB.ActionDelegate.BindDelegate(Actor, FuncName);
+                AB.ActionDelegate.BindDelegate(Actor, Input->FuncName);
                 InputComponent->AddActionBinding(AB);
             }
         }
     }
 
-    EInputEvent IEs[] = { IE_Pressed, IE_Released };
-    TSet<FName> DiffActionNames = DefaultActionNames.Difference(ActionNames);
-    for (TSet<FName>::TConstIterator It(DiffActionNames); It; ++It)
+    for (const FInputBindInfo &Input : BindInfo.ActionInputs)
     {
-        FName ActionName = *It;
-        for (int32 i = 0; i < 2; ++i)
-        {
-            FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *ActionName.ToString(), SReadableInputEvent[IEs[i]]));
-            if (LuaFunctions.Find(FuncName))
-            {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
-                FInputActionBinding AB(ActionName, IEs[i]);
-                AB.ActionDelegate.BindDelegate(Actor, FuncName);
-                InputComponent->AddActionBinding(AB);
-            }
-        }
+        if (Input.KeyEvent != IE_Pressed && Input.KeyEvent != IE_Released)
+            continue;
+        if (ActionNames.Contains(Input.Name) || !DefaultActionNames.Contains(Input.Name))
+            continue;
+
+        ULuaFunction::Override(InputActionFunc, Class, Input.FuncName);
+        FInputActionBinding AB(Input.Name, Input.KeyEvent);
+        AB.ActionDelegate.BindDelegate(Actor, Input.FuncName);
+        InputComponent->AddActionBinding(AB);
     }
 }
 
 /**
  * Replace key inputs
  */
-void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
+    if (BindInfo.KeyInputs.Num() == 0)
+        return;
+
     UClass *Class = Actor->GetClass();
+    auto FindInput = [&BindInfo](const FKey &Key, EInputEvent KeyEvent)
+    {
+        const FName Name = Key.GetFName();
+        return BindInfo.KeyInputs.FindByPredicate([Name, KeyEvent](const FInputBindInfo &Input) { return Input.KeyEvent == KeyEvent && Input.Name == Name; });
+    };
 
     TArray<FKey> Keys;
     TArray<bool> PairedKeys;
@@ -417,11 +534,10 @@ void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputCompon
             PairedKeys[Index] = true;
         }
 
-        FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *IKB.Chord.Key.ToString(), SReadableInputEvent[IKB.KeyEvent]));
-        if (LuaFunctions.Find(FuncName))
+        if (const FInputBindInfo *Input = FindInput(IKB.Chord.Key, IKB.KeyEvent))
         {
-            ULuaFunction::Override(InputActionFunc, Class, FuncName);
-            IKB.KeyDelegate.BindDelegate(Actor, FuncName);
+            ULuaFunction::Override(InputActionFunc, Class, Input->FuncName);
+            IKB.KeyDelegate.BindDelegate(Actor, Input->FuncName);
         }
     }
 
@@ -430,44 +546,39 @@ void UUnLuaManager::ReplaceKeyInputs(AActor *Actor, UInputComponent *InputCompon
         if (!PairedKeys[i])
         {
             EInputEvent IE = InputEvents[i] == IE_Pressed ? IE_Released : IE_Pressed;
-            FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *Keys[i].ToString(), SReadableInputEvent[IE]));
-            if (LuaFunctions.Find(FuncName))
+            if (const FInputBindInfo *Input = FindInput(Keys[i], IE))
             {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
+                ULuaFunction::Override(InputActionFunc, Class, Input->FuncName);
                 FInputKeyBinding IKB(FInputChord(Keys[i]), IE);
-                IKB.KeyDelegate.BindDelegate(Actor, FuncName);
+                IKB.KeyDelegate.BindDelegate(Actor, Input->FuncName);
                 InputComponent->KeyBindings.Add(IKB);
             }
         }
     }
 
-    EInputEvent IEs[] = { IE_Pressed, IE_Released };
-    for (const FKey &Key : AllKeys)
+    for (const FInputBindInfo &Input : BindInfo.KeyInputs)
     {
+        if (Input.KeyEvent != IE_Pressed && Input.KeyEvent != IE_Released)
+            continue;
+
+        const FKey Key(Input.Name);
         if (Keys.Find(Key) != INDEX_NONE)
-        {
             continue;
-        }
-        for (int32 i = 0; i < 2; ++i)
-        {
-            FName FuncName = FName(*FString::Printf(TEXT("%s_%s"), *Key.ToString(), SReadableInputEvent[IEs[i]]));
-            if (LuaFunctions.Find(FuncName))
-            {
-                ULuaFunction::Override(InputActionFunc, Class, FuncName);
-                FInputKeyBinding IKB(FInputChord(Key), IEs[i]);
-                IKB.KeyDelegate.BindDelegate(Actor, FuncName);
-                InputComponent->KeyBindings.Add(IKB);
-            }
-        }
+
+        ULuaFunction::Override(InputActionFunc, Class, Input.FuncName);
+        FInputKeyBinding IKB(FInputChord(Key), Input.KeyEvent);
+        IKB.KeyDelegate.BindDelegate(Actor, Input.FuncName);
+        InputComponent->KeyBindings.Add(IKB);
     }
 }
 
 /**
  * Replace axis inputs
  */
-void UUnLuaManager::ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
     UClass *Class = Actor->GetClass();
+    const TSet<FName> &LuaFunctions = BindInfo.LuaFunctions;
 
     TSet<FName> AxisNames;
     for (FInputAxisBinding &IAB : InputComponent->AxisBindings)
@@ -480,45 +591,49 @@ void UUnLuaManager::ReplaceAxisInputs(AActor *Actor, UInputComponent *InputCompo
         }
     }
 
-    TSet<FName> DiffAxisNames = DefaultAxisNames.Difference(AxisNames);
-    for (TSet<FName>::TConstIterator It(DiffAxisNames); It; ++It)
+    for (const FName &AxisName : BindInfo.DefaultAxisInputs)
     {
-        if (LuaFunctions.Find(*It))
-        {
-            ULuaFunction::Override(InputAxisFunc, Class, *It);
-            FInputAxisBinding &IAB = InputComponent->BindAxis(*It);
-            IAB.AxisDelegate.BindDelegate(Actor, *It);
-        }
+        if (AxisNames.Contains(AxisName))
+            continue;
+
+        ULuaFunction::Override(InputAxisFunc, Class, AxisName);
+        FInputAxisBinding &IAB = InputComponent->BindAxis(AxisName);
+        IAB.AxisDelegate.BindDelegate(Actor, AxisName);
     }
 }
 
 /**
  * Replace touch inputs
  */
-void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
+    if (BindInfo.TouchInputs.Num() == 0)
+        return;
+
     UClass *Class = Actor->GetClass();
+    auto FindInput = [&BindInfo](EInputEvent KeyEvent)
+    {
+        return BindInfo.TouchInputs.FindByPredicate([KeyEvent](const FInputBindInfo &Input) { return Input.KeyEvent == KeyEvent; });
+    };
 
     TArray<EInputEvent> InputEvents = { IE_Pressed, IE_Released, IE_Repeat };        // IE_DoubleClick?
     for (FInputTouchBinding &ITB : InputComponent->TouchBindings)
     {
         InputEvents.Remove(ITB.KeyEvent);
-        FName FuncName = FName(*FString::Printf(TEXT("Touch_%s"), SReadableInputEvent[ITB.KeyEvent]));
-        if (LuaFunctions.Find(FuncName))
+        if (const FInputBindInfo *Input = FindInput(ITB.KeyEvent))
         {
-            ULuaFunction::Override(InputTouchFunc, Class, FuncName);
-            ITB.TouchDelegate.BindDelegate(Actor, FuncName);
+            ULuaFunction::Override(InputTouchFunc, Class, Input->FuncName);
+            ITB.TouchDelegate.BindDelegate(Actor, Input->FuncName);
         }
     }
 
     for (EInputEvent IE : InputEvents)
     {
-        FName FuncName = FName(*FString::Printf(TEXT("Touch_%s"), SReadableInputEvent[IE]));
-        if (LuaFunctions.Find(FuncName))
+        if (const FInputBindInfo *Input = FindInput(IE))
         {
-            ULuaFunction::Override(InputTouchFunc, Class, FuncName);
+            ULuaFunction::Override(InputTouchFunc, Class, Input->FuncName);
             FInputTouchBinding ITB(IE);
-            ITB.TouchDelegate.BindDelegate(Actor, FuncName);
+            ITB.TouchDelegate.BindDelegate(Actor, Input->FuncName);
             InputComponent->TouchBindings.Add(ITB);
         }
     }
@@ -527,9 +642,10 @@ void UUnLuaManager::ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComp
 /**
  * Replace axis key inputs
  */
-void UUnLuaManager::ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
     UClass *Class = Actor->GetClass();
+    const TSet<FName> &LuaFunctions = BindInfo.LuaFunctions;
     for (FInputAxisKeyBinding &IAKB : InputComponent->AxisKeyBindings)
     {
         FName FuncName = IAKB.AxisKey.GetFName();
@@ -544,9 +660,10 @@ void UUnLuaManager::ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputCo
 /**
  * Replace vector axis inputs
  */
-void UUnLuaManager::ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
     UClass *Class = Actor->GetClass();
+    const TSet<FName> &LuaFunctions = BindInfo.LuaFunctions;
     for (FInputVectorAxisBinding &IVAB : InputComponent->VectorAxisBindings)
     {
         FName FuncName = IVAB.AxisKey.GetFName();
@@ -561,9 +678,10 @@ void UUnLuaManager::ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *Inpu
 /**
  * Replace gesture inputs
  */
-void UUnLuaManager::ReplaceGestureInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions)
+void UUnLuaManager::ReplaceGestureInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo)
 {
     UClass *Class = Actor->GetClass();
+    const TSet<FName> &LuaFunctions = BindInfo.LuaFunctions;
     for (FInputGestureBinding &IGB : InputComponent->GestureBindings)
     {
         FName FuncName = IGB.GestureKey.GetFName();
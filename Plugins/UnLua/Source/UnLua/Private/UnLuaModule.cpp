@@ -27,10 +27,12 @@
 #include "UnLuaModule.h"
 #include "DefaultParamCollection.h"
 #include "GameDelegates.h"
+#include "LuaDynamicBinding.h"
 #include "LuaEnvLocator.h"
 #include "UnLuaDebugBase.h"
 #include "UnLuaInterface.h"
 #include "UnLuaSettings.h"
+#include "Components/InputComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "Registries/ClassRegistry.h"
 #include "Registries/EnumRegistry.h"
@@ -98,33 +100,64 @@ namespace UnLua
                 OnHandleSystemEnsureHandle = FCoreDelegates::OnHandleSystemEnsure.AddRaw(this, &FUnLuaModule::OnSystemError);
                 GUObjectArray.AddUObjectCreateListener(this);
                 GUObjectArray.AddUObjectDeleteListener(this);
+                ResetBindFlags();
+#if WITH_EDITOR
+                if (GEditor)
+                    OnBlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FUnLuaModule::ResetBindFlags);
+#endif
 
                 const auto& Settings = *GetMutableDefault<UUnLuaSettings>();
                 const auto EnvLocatorClass = *Settings.EnvLocatorClass == nullptr ? ULuaEnvLocator::StaticClass() : *Settings.EnvLocatorClass;
                 EnvLocator = NewObject<ULuaEnvLocator>(GetTransientPackage(), EnvLocatorClass);
                 EnvLocator->AddToRoot();
                 FDeadLoopCheck::Timeout = Settings.DeadLoopCheck;
+                FDeadLoopCheck::Budgets[(int32)FDeadLoopCheck::EEntryPoint::Tick] = {Settings.TickBudget.MaxInstructions, Settings.TickBudget.MaxMilliseconds};
+                FDeadLoopCheck::Budgets[(int32)FDeadLoopCheck::EEntryPoint::Event] = {Settings.EventBudget.MaxInstructions, Settings.EventBudget.MaxMilliseconds};
+                FDeadLoopCheck::Budgets[(int32)FDeadLoopCheck::EEntryPoint::RPC] = {Settings.RPCBudget.MaxInstructions, Settings.RPCBudget.MaxMilliseconds};
+                FDeadLoopCheck::bAbortOnBudgetExceeded = Settings.bAbortOnScriptBudgetExceeded;
+                FDeadLoopCheck::CheckInterval = Settings.ScriptBudgetCheckInterval;
                 FDanglingCheck::Enabled = Settings.DanglingCheck;
 
-                for (const auto Class : TObjectRange<UClass>())
+                TArray<UClass*> PreBindTargets;
+                for (const auto& ClassPath : Settings.PreBindClasses)
                 {
-                    for (const auto& ClassPath : Settings.PreBindClasses)
-                    {
-                        if (!ClassPath.IsValid())
-                            continue;
+                    if (!ClassPath.IsValid())
+                        continue;
 
-                        const auto TargetClass = ClassPath.ResolveClass();
-                        if (!TargetClass)
-                            continue;
+                    if (const auto TargetClass = ClassPath.ResolveClass())
+                        PreBindTargets.Add(TargetClass);
+                }
 
+                TArray<UClass*> PreBindClasses;
+                for (const auto Class : TObjectRange<UClass>())
+                {
+                    for (const auto TargetClass : PreBindTargets)
+                    {
                         if (Class->IsChildOf(TargetClass))
                         {
-                            const auto Env = EnvLocator->Locate(Class);
-                            Env->TryBind(Class);
+                            PreBindClasses.Add(Class);
                             break;
                         }
                     }
                 }
+
+                // compile modules of the classes in background while binding them one by one
+                TMap<FLuaEnv*, TArray<FString>> PreloadModules;
+                const auto ModuleLocator = Settings.ModuleLocatorClass.GetDefaultObject();
+                for (const auto Class : PreBindClasses)
+                {
+                    const auto ModuleName = ModuleLocator ? ModuleLocator->Locate(Class) : FString();
+                    if (!ModuleName.IsEmpty())
+                        PreloadModules.FindOrAdd(EnvLocator->Locate(Class)).Add(ModuleName);
+                }
+                for (const auto& Pair : PreloadModules)
+                    Pair.Key->PreloadModules(Pair.Value);
+
+                for (const auto Class : PreBindClasses)
+                {
+                    const auto Env = EnvLocator->Locate(Class);
+                    Env->TryBind(Class);
+                }
             }
             else
             {
@@ -132,6 +165,11 @@ namespace UnLua
                 FCoreDelegates::OnHandleSystemEnsure.Remove(OnHandleSystemEnsureHandle);
                 GUObjectArray.RemoveUObjectCreateListener(this);
                 GUObjectArray.RemoveUObjectDeleteListener(this);
+#if WITH_EDITOR
+                if (GEditor)
+                    GEditor->OnBlueprintCompiled().Remove(OnBlueprintCompiledHandle);
+#endif
+                ResetBindFlags();
                 EnvLocator->Reset();
                 EnvLocator->RemoveFromRoot();
                 EnvLocator = nullptr;
@@ -159,6 +197,7 @@ namespace UnLua
         {
             if (!bIsActive)
                 return;
+            ResetBindFlags();
             EnvLocator->HotReload();
         }
 
@@ -171,6 +210,11 @@ namespace UnLua
 
             UObject* Object = (UObject*)ObjectBase;
 
+            // 绝大多数对象既不需要绑定也不需要替换输入，查一次缓存就可以返回
+            const auto Class = Object->GetClass();
+            if (GetBindFlags(Class) == BF_None && !GLuaDynamicBinding.IsValid(Class))
+                return;
+
             const auto Env = EnvLocator->Locate(Object);
             // UE_LOG(LogTemp, Log, TEXT("Locate %s for %s"), *Env->GetName(), *ObjectBase->GetFName().ToString());
             Env->TryBind(Object);
@@ -183,6 +227,12 @@ namespace UnLua
             if (!bIsActive)
                 return;
 
+            {
+                // the class of the object may be freed in the same purge, removing a non-class key is a no-op
+                FRWScopeLock Lock(BindFlagsLock, SLT_Write);
+                BindFlags.Remove((UClass*)Object);
+            }
+
             if (FClassRegistry::StaticUnregister(Object))
                 return;
 
@@ -222,6 +272,51 @@ namespace UnLua
                 GLog->Flush();
         }
 
+        enum EBindFlags : uint8
+        {
+            BF_None = 0,
+            BF_Bind = 1 << 0,
+            BF_ReplaceInputs = 1 << 1,
+            BF_All = BF_Bind | BF_ReplaceInputs,
+        };
+
+        /**
+         * 获取指定类的对象在创建时需要做的处理，结果按类缓存
+         * 类重新编译、删除或者热重载后缓存失效
+         */
+        uint8 GetBindFlags(UClass* Class)
+        {
+            // UClass对象创建时还没有链接完成，每次都走完整流程
+            if (Class->HasAnyClassCastFlags(CASTCLASS_UClass))
+                return BF_All;
+
+            {
+                FRWScopeLock Lock(BindFlagsLock, SLT_ReadOnly);
+                if (const auto Flags = BindFlags.Find(Class))
+                    return *Flags;
+            }
+
+            uint8 Flags = BF_None;
+            if (Class->ImplementsInterface(UUnLuaInterface::StaticClass()) && !Class->GetName().Contains(TEXT("SKEL_")))
+                Flags |= BF_Bind;
+            if (Class->IsChildOf<UInputComponent>())
+                Flags |= BF_ReplaceInputs;
+
+            // 加载中的类接口信息可能还不完整，先不缓存
+            if (Class->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad) || Class->HasAnyInternalFlags(EInternalObjectFlags::AsyncLoading))
+                return Flags;
+
+            FRWScopeLock Lock(BindFlagsLock, SLT_Write);
+            BindFlags.Add(Class, Flags);
+            return Flags;
+        }
+
+        void ResetBindFlags()
+        {
+            FRWScopeLock Lock(BindFlagsLock, SLT_Write);
+            BindFlags.Reset();
+        }
+
 #if WITH_EDITOR
 
         void OnPreBeginPIE(bool bIsSimulating)
@@ -310,6 +405,11 @@ namespace UnLua
         ULuaEnvLocator* EnvLocator = nullptr;
         FDelegateHandle OnHandleSystemErrorHandle;
         FDelegateHandle OnHandleSystemEnsureHandle;
+        TMap<UClass*, uint8> BindFlags;
+        FRWLock BindFlagsLock;
+#if WITH_EDITOR
+        FDelegateHandle OnBlueprintCompiledHandle;
+#endif
 #if ALLOW_CONSOLE
         TUniquePtr<FUnLuaConsoleCommands> ConsoleCommands;
 #endif
@@ -28,7 +28,13 @@
 #include "HAL/Platform.h"
 #include "LuaDanglingCheck.h"
 #include "LuaDeadLoopCheck.h"
+#include "LuaHooks.h"
+#include "ParamBufferArena.h"
 #include "LuaModuleLocator.h"
+#include "LuaModulePreloader.h"
+#include "LuaBytecodePak.h"
+#include "LuaSmallBlockPool.h"
+#include "LuaNameCache.h"
 
 namespace UnLua
 {
@@ -58,7 +64,17 @@ namespace UnLua
 
         static FLuaEnv* FindEnv(const lua_State* L);
 
-        static FLuaEnv& FindEnvChecked(const lua_State* L);
+        /**
+         * Get the env which owns the given lua_State. The env pointer is stored in the extra space of the main
+         * thread and copied into every coroutine, so this is a single load without any map lookup.
+         */
+        static FORCEINLINE FLuaEnv& FindEnvChecked(const lua_State* L)
+        {
+            FLuaEnv* Env = *(FLuaEnv**)lua_getextraspace(L);
+            check(Env);
+            checkSlow(Env == FindEnv(L));
+            return *Env;
+        }
 
         void Start(const TMap<FString, UObject*>& Args = {});
 
@@ -70,6 +86,16 @@ namespace UnLua
 
         virtual void NotifyUObjectDeleted(const UObjectBase* ObjectBase, int32 Index) override;
 
+        /**
+         * Process the deleted objects queued for the registries keyed by classes/functions. It must be called
+         * before looking up those registries, as the memory of a deleted object may be reused by a new one.
+         */
+        FORCEINLINE void FlushDeletedObjects()
+        {
+            if (UNLIKELY(DeletedObjects.Num() > 0))
+                ProcessDeletedObjects();
+        }
+
         virtual void OnUObjectArrayShutdown() override;
 
         virtual bool TryBind(UObject* Object);
@@ -112,6 +138,31 @@ namespace UnLua
 
         FORCEINLINE FDeadLoopCheck* GetDeadLoopCheck() const { return DeadLoopCheck; }
 
+        FORCEINLINE FLuaHooks* GetHooks() const { return Hooks; }
+
+        FORCEINLINE FParamBufferArena* GetParamBufferArena() const { return ParamBufferArena; }
+
+        FORCEINLINE FModulePreloader* GetModulePreloader() const { return ModulePreloader; }
+
+        FORCEINLINE FLuaNameCache* GetNameCache() const { return NameCache; }
+
+        /** Registry reference of the weak table 'StructMap' which caches pushed struct pointers */
+        FORCEINLINE int32 GetStructMapRef() const { return StructMapRef; }
+
+        /** Registry reference of the weak table 'ArrayMap' which caches pushed static arrays */
+        FORCEINLINE int32 GetArrayMapRef() const { return ArrayMapRef; }
+
+        /**
+         * Read and precompile the given modules on worker threads, 'require' of them will use the bytecode directly
+         */
+        void PreloadModules(const TArray<FString>& ModuleNames);
+
+        /**
+         * Mount an archive of precompiled chunks built by luapak or the UnLuaBuildBytecodePak commandlet.
+         * Modules in mounted archives are loaded without any copy, before searching the file system.
+         */
+        bool MountBytecodePak(const FString& Path);
+
         void AddLoader(const FLuaFileLoader Loader);
 
         void AddBuiltInLoader(const FString InName, lua_CFunction Loader);
@@ -127,6 +178,8 @@ namespace UnLua
 
         static int LoadFromCustomLoader(lua_State* L);
 
+        static int LoadFromBytecodePak(lua_State* L);
+
         static int LoadFromFileSystem(lua_State* L);
 
         static void* DefaultLuaAllocator(void* ud, void* ptr, size_t osize, size_t nsize);
@@ -152,6 +205,10 @@ namespace UnLua
 
         void OnAsyncLoadingFlushUpdate();
 
+        void OnPostGarbageCollect();
+
+        void ProcessDeletedObjects();
+
         void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaTime);
 
         void RegisterDelegates();
@@ -161,6 +218,7 @@ namespace UnLua
         static TMap<lua_State*, FLuaEnv*> AllEnvs;
         TMap<FString, lua_CFunction> BuiltinLoaders;
         TArray<FLuaFileLoader> CustomLoaders;
+        TArray<TUniquePtr<FBytecodePak>> BytecodePaks;
         TArray<FWeakObjectPtr> Candidates; // binding candidates during async loading
         ULuaModuleLocator* ModuleLocator;
         FCriticalSection CandidatesLock;
@@ -176,9 +234,18 @@ namespace UnLua
         FEnumRegistry* EnumRegistry;
         FDanglingCheck* DanglingCheck;
         FDeadLoopCheck* DeadLoopCheck;
+        FLuaHooks* Hooks;
+        FParamBufferArena* ParamBufferArena;
+        FModulePreloader* ModulePreloader;
+        FLuaNameCache* NameCache;
+        FLuaSmallBlockPool* SmallBlockPool = nullptr;
+        int32 StructMapRef;
+        int32 ArrayMapRef;
         TMap<lua_State*, int32> ThreadToRef;
         TMap<int32, lua_State*> RefToThread;
         FDelegateHandle OnAsyncLoadingFlushUpdateHandle;
+        FDelegateHandle PostGarbageCollectHandle;
+        TArray<UObject*> DeletedObjects; // deleted objects waiting for batched cleanup
         TArray<UInputComponent*> CandidateInputComponents;
         FDelegateHandle OnWorldTickStartHandle;
         FString Name = TEXT("Env_0");
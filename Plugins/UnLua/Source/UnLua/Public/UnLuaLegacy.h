@@ -740,7 +740,11 @@ namespace UnLua
         int32 MessageHandlerIdx = lua_gettop(L) - 1;
         check(MessageHandlerIdx > 0);
         int32 NumArgs = PushArgs<false>(L, Forward<T>(Args)...);
-        int32 Code = lua_pcall(L, NumArgs, LUA_MULTRET, MessageHandlerIdx);
+        int32 Code;
+        {
+            const FParamBufferArena::FScope ArenaScope(*Env->GetParamBufferArena());
+            Code = lua_pcall(L, NumArgs, LUA_MULTRET, MessageHandlerIdx);
+        }
         int32 TopIdx = lua_gettop(L);
         if (Code == LUA_OK)
         {
@@ -38,7 +38,7 @@ public:
 
     bool Bind(UObject *Object, const TCHAR *InModuleName, int32 InitializerTableRef = LUA_NOREF);
 
-    void NotifyUObjectDeleted(const UObjectBase *Object);
+    void NotifyUObjectsDeleted(const TArray<UObject*>& Objects);
 
     void Cleanup();
 
@@ -92,16 +92,13 @@ public:
     void TriggerAnimNotify();
 
 private:
-    /* 将一个UClass绑定到Lua模块，根据这个模块定义的函数列表来覆盖上面的UFunction */
-    bool BindClass(UClass *Class, const FString &InModuleName, FString &Error);
-
-    void ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
-    void ReplaceGestureInputs(AActor *Actor, UInputComponent *InputComponent, TSet<FName> &LuaFunctions);
+    /* 由Lua函数名（如 Jump_Pressed）解析出来的输入绑定 */
+    struct FInputBindInfo
+    {
+        FName Name;             // action/key name
+        FName FuncName;
+        EInputEvent KeyEvent;
+    };
 
     struct FClassBindInfo
     {
@@ -110,8 +107,29 @@ private:
         int TableRef;
         TSet<FName> LuaFunctions;
         TMap<FName, UFunction*> UEFunctions;
+        TArray<FInputBindInfo> ActionInputs;    // <ActionName>_<InputEvent>
+        TArray<FInputBindInfo> KeyInputs;       // <KeyName>_<InputEvent>
+        TArray<FInputBindInfo> TouchInputs;     // Touch_<InputEvent>
+        TArray<FName> DefaultAxisInputs;        // default axis names which have Lua functions
     };
 
+    /* 将一个UClass绑定到Lua模块，根据这个模块定义的函数列表来覆盖上面的UFunction */
+    bool BindClass(UClass *Class, const FString &InModuleName, FString &Error);
+
+    /* 为已经绑定过的UClass的一个实例创建Lua对象，并调用模块的Initialize函数 */
+    bool BindInstance(UObject *Object, UClass *Class, FClassBindInfo &BindInfo, int32 InitializerTableRef);
+
+    /* 预先解析出Lua模块中的输入函数，替换输入时直接按列表绑定 */
+    void BuildInputBindInfo(FClassBindInfo &BindInfo);
+
+    void ReplaceActionInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceKeyInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceAxisInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceTouchInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceAxisKeyInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceVectorAxisInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+    void ReplaceGestureInputs(AActor *Actor, UInputComponent *InputComponent, const FClassBindInfo &BindInfo);
+
     TMap<UClass*, FClassBindInfo> Classes;
 
     TSet<FName> DefaultAxisNames;
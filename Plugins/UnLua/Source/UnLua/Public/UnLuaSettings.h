@@ -19,6 +19,19 @@
 #include "LuaModuleLocator.h"
 #include "UnLuaSettings.generated.h"
 
+USTRUCT()
+struct FUnLuaScriptBudget
+{
+    GENERATED_BODY()
+
+    /** Max lua VM instructions of a single call, 0 for unlimited. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    int32 MaxInstructions = 0;
+
+    /** Max milliseconds of a single call, 0 for unlimited. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    float MaxMilliseconds = 0;
+};
 
 UCLASS(Config=UnLua, DefaultConfig, Meta=(DisplayName="UnLua"))
 class UNLUA_API UUnLuaSettings : public UObject
@@ -36,6 +49,26 @@ public:
     UPROPERTY(Config, EditAnywhere, Category="Runtime")
     int32 DeadLoopCheck = 0;
 
+    /** Budget of each call to lua from Tick/ReceiveTick. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    FUnLuaScriptBudget TickBudget;
+
+    /** Budget of each call to lua from other overridden events. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    FUnLuaScriptBudget EventBudget;
+
+    /** Budget of each call to lua from RPC handlers. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    FUnLuaScriptBudget RPCBudget;
+
+    /** Raise a lua error when a call exceeds its budget, otherwise only report it. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    bool bAbortOnScriptBudgetExceeded = false;
+
+    /** Number of lua VM instructions between two checks of DeadLoopCheck and script budgets. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime", Meta=(ClampMin="100"))
+    int32 ScriptBudgetCheckInterval = 1000;
+
     /** Prevent dangling pointers in lua. */
     UPROPERTY(Config, EditAnywhere, Category="Runtime")
     bool DanglingCheck = false;
@@ -51,6 +84,30 @@ public:
     UPROPERTY(Config, EditAnywhere, Category=Runtime, Meta=(AllowAbstract="false", DisplayName="LuaModuleLocator"))
     TSubclassOf<ULuaModuleLocator> ModuleLocatorClass = ULuaModuleLocator::StaticClass();
 
+    /** List of lua modules to read and precompile on worker threads when lua env created. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    TArray<FString> PreloadModules;
+
+    /** List of lua bytecode paks to mount when lua env created, relative paths are based on the project directory. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    TArray<FString> BytecodePaks;
+
+    /** Reuse memory of small lua objects (e.g. userdata of FVector) with size class free lists, memory is retained until lua env closed. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    bool bPoolSmallLuaObjects = false;
+
+    /** Register plain old data structs (e.g. FVector/FRotator) without '__gc', so their userdata skip the finalizer. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    bool bPODStructsWithoutGC = false;
+
+    /** Pass FVector/FVector2D/FRotator values as plain lua tables (e.g. {X = 1, Y = 2, Z = 3}) instead of userdata. Properties of these types are read by value. Restart required. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    bool bMathStructsAsTables = false;
+
+    /** Create the lua instance table of a bound object on its first lua access or overridden call instead of at binding, for modules without 'Initialize'. */
+    UPROPERTY(Config, EditAnywhere, Category="Runtime")
+    bool bLazyInstanceTables = false;
+
     /** List of classes to bind on startup. */
     UPROPERTY(config, EditAnywhere, Category=Runtime, meta = (MetaClass="Object", AllowAbstract="True", DisplayName = "List of classes to bind on startup"))
     TArray<FSoftClassPath> PreBindClasses;
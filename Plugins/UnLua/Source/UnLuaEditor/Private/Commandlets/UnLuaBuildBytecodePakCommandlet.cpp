@@ -0,0 +1,139 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "Commandlets/UnLuaBuildBytecodePakCommandlet.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UnLuaBase.h"
+#include "UnLuaFunctionLibrary.h"
+#include "lua.hpp"
+
+#ifdef __cplusplus
+#if !LUA_COMPILE_AS_CPP
+extern "C" {
+#endif
+#endif
+
+#include "lpak.h"
+
+#ifdef __cplusplus
+#if !LUA_COMPILE_AS_CPP
+}
+#endif
+#endif
+
+static int WritePak(lua_State* L, const void* Data, size_t Size, void* UserData)
+{
+    static_cast<TArray<uint8>*>(UserData)->Append(static_cast<const uint8*>(Data), Size);
+    return 0;
+}
+
+struct FDumpContext
+{
+    TArray<uint8>* Pak;
+    bool bStrip;
+};
+
+static int DumpPak(lua_State* L)
+{
+    const auto Context = static_cast<FDumpContext*>(lua_touserdata(L, 2));
+    lpak_dump(L, 1, WritePak, Context->Pak, Context->bStrip);
+    return 0;
+}
+
+UUnLuaBuildBytecodePakCommandlet::UUnLuaBuildBytecodePakCommandlet(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+}
+
+int32 UUnLuaBuildBytecodePakCommandlet::Main(const FString& Params)
+{
+    const FString ScriptRoot = UUnLuaFunctionLibrary::GetScriptRootPath();
+    FString OutputPath = FPaths::ProjectContentDir() / TEXT("Script.lpak");
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    // shipped paks don't carry debug information unless asked to
+    const bool bStrip = !FParse::Param(*Params, TEXT("NoStrip"));
+
+    TArray<FString> Files;
+    IFileManager::Get().FindFilesRecursive(Files, *ScriptRoot, TEXT("*.lua"), true, false);
+
+    lua_State* L = luaL_newstate();
+    lua_newtable(L);
+
+    int32 NumErrors = 0;
+    int32 NumModules = 0;
+    for (const auto& File : Files)
+    {
+        TArray<uint8> Data;
+        if (!FFileHelper::LoadFileToArray(Data, *File))
+        {
+            UE_LOG(LogUnLua, Error, TEXT("Failed to read lua file : %s"), *File);
+            ++NumErrors;
+            continue;
+        }
+
+        FString RelativePath = File;
+        FPaths::MakePathRelativeTo(RelativePath, *ScriptRoot);
+        const FString ModuleName = FPaths::ChangeExtension(RelativePath, TEXT("")).Replace(TEXT("/"), TEXT("."));
+
+        const char* Buffer = (const char*)Data.GetData();
+        size_t Size = Data.Num();
+        if (Size > 3 && Buffer[0] == static_cast<char>(0xEF) && Buffer[1] == static_cast<char>(0xBB) && Buffer[2] == static_cast<char>(0xBF))
+        {
+            Buffer += 3;
+            Size -= 3;
+        }
+
+        // 使用相对脚本目录的chunkname，避免把构建机的绝对路径带进发布包的报错信息里
+        const FString ChunkName = TEXT("@") + RelativePath;
+        if (luaL_loadbufferx(L, Buffer, Size, TCHAR_TO_UTF8(*ChunkName), "t") != LUA_OK)
+        {
+            UE_LOG(LogUnLua, Error, TEXT("Failed to compile lua file : %s"), UTF8_TO_TCHAR(lua_tostring(L, -1)));
+            lua_pop(L, 1);
+            ++NumErrors;
+            continue;
+        }
+        lua_setfield(L, -2, TCHAR_TO_UTF8(*ModuleName));
+        ++NumModules;
+    }
+
+    TArray<uint8> Pak;
+    FDumpContext Context{&Pak, bStrip};
+    lua_pushcfunction(L, DumpPak);
+    lua_insert(L, -2);
+    lua_pushlightuserdata(L, &Context);
+    if (lua_pcall(L, 2, 0, 0) != LUA_OK)
+    {
+        UE_LOG(LogUnLua, Error, TEXT("Failed to write lua bytecode pak : %s"), UTF8_TO_TCHAR(lua_tostring(L, -1)));
+        ++NumErrors;
+    }
+    lua_close(L);
+
+    if (NumErrors > 0)
+    {
+        UE_LOG(LogUnLua, Error, TEXT("Build lua bytecode pak failed with %d error(s)."), NumErrors);
+        return 1;
+    }
+
+    if (!FFileHelper::SaveArrayToFile(Pak, *OutputPath))
+    {
+        UE_LOG(LogUnLua, Error, TEXT("Failed to save lua bytecode pak : %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogUnLua, Display, TEXT("%d lua module(s) saved to %s"), NumModules, *OutputPath);
+    return 0;
+}
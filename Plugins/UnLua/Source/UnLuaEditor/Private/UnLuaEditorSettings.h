@@ -78,6 +78,10 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Build")
     bool bEnableCallOverriddenFunction = true;
 
+    /** Call native UFunctions with only POD parameters without reflection. (Requires restart to take effect) */
+    UPROPERTY(config, EditAnywhere, Category = "Build")
+    bool bEnableFastNativeCall = false;
+
     /** Whether or not compile lua module as c++ code. (Requires restart to take effect) */
     UPROPERTY(config, EditAnywhere, Category = "Build")
     bool bLuaCompileAsCpp = false;
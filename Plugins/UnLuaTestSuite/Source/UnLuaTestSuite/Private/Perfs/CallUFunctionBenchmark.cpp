@@ -0,0 +1,58 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "UnLuaTestCommon.h"
+#include "Misc/AutomationTest.h"
+#include "Perfs/UnLuaBenchmarkProxy.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+struct FUnLuaBenchmark_CallUFunction : FUnLuaTestBase
+{
+    virtual bool InstantTest() override
+    {
+        const auto Proxy = GetWorld()->SpawnActor<AUnLuaBenchmarkProxy>();
+        UnLua::PushUObject(L, Proxy);
+        lua_setglobal(L, "G_Proxy");
+
+        const auto Chunk = R"(
+            local N = 1000000
+            local Proxy = G_Proxy
+
+            local StartTime = os.clock()
+            for i = 1, N do
+                Proxy:NOP()
+            end
+            local MethodCost = os.clock() - StartTime
+
+            local NOP = Proxy.NOP
+            StartTime = os.clock()
+            for i = 1, N do
+                NOP(Proxy)
+            end
+            return MethodCost, os.clock() - StartTime
+        )";
+        UnLua::RunChunk(L, Chunk);
+
+        const auto MethodCost = lua_tonumber(L, -2);
+        const auto ClosureCost = lua_tonumber(L, -1);
+        GetTestRunner().AddInfo(FString::Printf(TEXT("void NOP(): %fns, void NOP() with cached closure: %fns"), MethodCost * 1000.0, ClosureCost * 1000.0));
+        return true;
+    }
+};
+
+IMPLEMENT_UNLUA_INSTANT_TEST(FUnLuaBenchmark_CallUFunction, TEXT("UnLua.Benchmark.CallUFunction 调用1M次空UFunction，对比方法调用与缓存闭包调用的耗时"))
+
+#endif
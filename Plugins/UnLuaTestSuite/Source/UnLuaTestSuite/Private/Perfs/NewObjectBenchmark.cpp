@@ -0,0 +1,51 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static double NewObjects(const int32 N)
+{
+    const auto StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < N; i++)
+        NewObject<UObject>(GetTransientPackage());
+    const auto Cost = FPlatformTime::Seconds() - StartTime;
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    return Cost;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnLuaBenchmark_NewObject, TEXT("UnLua.Benchmark.NewObject 创建1M个普通UObject，对比UnLua启用与未启用的耗时"),
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FUnLuaBenchmark_NewObject::RunTest(const FString& Parameters)
+{
+    constexpr int32 N = 1000000;
+    const bool bWasActive = UnLua::IsEnabled();
+
+    UnLua::Shutdown();
+    const auto InactiveCost = NewObjects(N);
+
+    UnLua::Startup();
+    const auto ActiveCost = NewObjects(N);
+
+    if (!bWasActive)
+        UnLua::Shutdown();
+
+    AddInfo(FString::Printf(TEXT("inactive: %fs, active: %fs, overhead per object: %fns"), InactiveCost, ActiveCost, (ActiveCost - InactiveCost) * 1000000000.0 / N));
+    return true;
+}
+
+#endif
@@ -0,0 +1,91 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "LuaEnv.h"
+#include "LuaFunction.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/DispatchTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FFunctionRegistrySpec, "UnLua.API.FunctionRegistry", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    lua_State* L;
+
+    static void NotifyDeleted(UnLua::FLuaEnv& Env, UObject* Object)
+    {
+        // the same as what GUObjectArray does when the object is destroyed
+        Env.NotifyUObjectDeleted(Object, Object->GetUniqueID());
+    }
+END_DEFINE_SPEC(FFunctionRegistrySpec)
+
+void FFunctionRegistrySpec::Define()
+{
+    BeforeEach([this]
+    {
+        UnLua::Startup();
+        L = UnLua::GetState();
+    });
+
+    Describe(TEXT("Dispatch"), [this]()
+    {
+        It(TEXT("对象解绑后重新绑定，调用新的Lua实例"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<UDispatchTestStub>();
+            TEST_EQUAL(Object->GetCallCount(), 1);
+            TEST_EQUAL(Object->GetCallCount(), 2);
+
+            NotifyDeleted(UnLua::FLuaEnv::FindEnvChecked(L), Object);
+            TEST_EQUAL(Object->GetCallCount(), 1);
+        });
+
+        It(TEXT("Lua环境重启后，不使用旧环境的缓存"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<UDispatchTestStub>();
+            Object->AddToRoot();
+            TEST_EQUAL(Object->GetCallCount(), 1);
+            TEST_EQUAL(Object->GetCallCount(), 2);
+
+            UnLua::Shutdown();
+            UnLua::Startup();
+            L = UnLua::GetState();
+
+            // binds the class to the new env again
+            NewObject<UDispatchTestStub>();
+            TEST_EQUAL(Object->GetCallCount(), 1);
+            Object->RemoveFromRoot();
+        });
+
+        It(TEXT("ULuaFunction释放后，重新查找Lua函数"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<UDispatchTestStub>();
+            TEST_EQUAL(Object->GetCallCount(), 1);
+
+            const auto Function = Cast<ULuaFunction>(Object->FindFunction(TEXT("GetCallCount")));
+            TEST_TRUE(Function != nullptr);
+            if (!Function)
+                return;
+
+            NotifyDeleted(UnLua::FLuaEnv::FindEnvChecked(L), Function);
+            TEST_EQUAL(Object->GetCallCount(), 2);
+        });
+    });
+
+    AfterEach([this]
+    {
+        UnLua::Shutdown();
+    });
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,70 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaTestHelpers.h"
+#include "UnLuaModule.h"
+#include "UnLuaSettings.h"
+#include "UnLuaTemplate.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/DanglingCheckTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FLuaDanglingCheckSpec, "UnLua.Settings", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FLuaDanglingCheckSpec)
+
+void FLuaDanglingCheckSpec::Define()
+{
+    Describe(TEXT("DanglingCheck"), [this]()
+    {
+        AfterEach(EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+            Settings.DanglingCheck = false;
+        });
+
+        It(TEXT("内层调用结束时只释放内层引用的容器"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+            Settings.DanglingCheck = true;
+
+            UnLua::Startup();
+
+            const auto Env = IUnLuaModule::Get().GetEnv();
+            const auto L = Env->GetMainState();
+            const auto Stub = NewObject<UDanglingCheckTestStub>();
+            Stub->OuterArray.Add(1);
+            Stub->InnerArray.Add(2);
+            UnLua::PushUObject(L, Stub);
+            lua_setglobal(L, "G_Stub");
+
+            // the outer guard is the chunk, the inner one is the overridden event called from C++
+            const auto Chunk = R"(
+                local OuterArray = G_Stub.OuterArray
+                G_Stub:CallCapture()
+                local InnerOk = pcall(function() return G_InnerArray:Num() end)
+                local OuterOk, OuterNum = pcall(function() return OuterArray:Num() end)
+                return InnerOk, OuterOk, OuterNum
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_FALSE(lua_toboolean(L, -3));
+            TEST_TRUE(lua_toboolean(L, -2));
+            TEST_EQUAL(lua_tointeger(L, -1), (lua_Integer)1);
+
+            UnLua::Shutdown();
+        });
+    });
+}
+
+#endif
@@ -16,7 +16,9 @@
 #include "UnLuaModule.h"
 #include "UnLuaSettings.h"
 #include "UnLuaTemplate.h"
+#include "HAL/IConsoleManager.h"
 #include "Misc/AutomationTest.h"
+#include "Tests/BudgetTest.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
 
@@ -59,6 +61,60 @@ void FLuaDeadLoopCheckSpec::Define()
             UnLua::Shutdown();
         });
     });
+
+    Describe(TEXT("ScriptBudget"), [this]()
+    {
+        BeforeEach(EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+            Settings.EventBudget.MaxInstructions = 10000;
+            Settings.bAbortOnScriptBudgetExceeded = true;
+            Settings.ScriptBudgetCheckInterval = 100;
+
+            UnLua::Startup();
+        });
+
+        AfterEach(EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            UnLua::Shutdown();
+
+            auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+            Settings.EventBudget = FUnLuaScriptBudget();
+            Settings.bAbortOnScriptBudgetExceeded = false;
+            Settings.ScriptBudgetCheckInterval = 1000;
+        });
+
+        It(TEXT("中断超出预算的事件调用，并可以用lua.budget清除记录"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Env = IUnLuaModule::Get().GetEnv();
+            const auto Stub = NewObject<UBudgetTestStub>();
+
+            AddExpectedError(TEXT("exceeded budget"), EAutomationExpectedErrorFlags::Contains);
+            TEST_EQUAL(Stub->Loop(10000000), 0);
+            TEST_EQUAL(Env->GetDeadLoopCheck()->GetReports().Num(), 1);
+
+            IConsoleManager::Get().ProcessUserConsoleInput(TEXT("lua.budget reset"), *GLog, nullptr);
+            TEST_EQUAL(Env->GetDeadLoopCheck()->GetReports().Num(), 0);
+        });
+
+        It(TEXT("不中断没有预算的调用"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Env = IUnLuaModule::Get().GetEnv();
+            const auto Chunk = R"(
+                G_Count = 0
+                for _ = 1, 100000 do
+                    G_Count = G_Count + 1
+                end
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+
+            const auto L = Env->GetMainState();
+            lua_getglobal(L, "G_Count");
+            TEST_EQUAL(lua_tointeger(L, -1), (lua_Integer)100000);
+            lua_pop(L, 1);
+            TEST_EQUAL(Env->GetDeadLoopCheck()->GetReports().Num(), 0);
+        });
+    });
 }
 
 #endif
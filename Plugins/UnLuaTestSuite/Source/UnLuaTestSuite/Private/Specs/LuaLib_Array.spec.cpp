@@ -13,8 +13,11 @@
 // See the License for the specific language governing permissions and limitations under the License.
 
 #include "UnLuaBase.h"
+#include "UnLuaModule.h"
+#include "UnLuaSettings.h"
 #include "UnLuaTemplate.h"
 #include "UnLuaTestHelpers.h"
+#include "Tests/Issue517Test.h"
 #include "Misc/AutomationTest.h"
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -643,6 +646,185 @@ void FUnLuaLibArraySpec::Define()
             TEST_EQUAL(lua_tointeger(L, -1), 2LL);
             TEST_EQUAL(lua_tointeger(L, -2), 1LL);
         });
+
+        It(TEXT("转换TArray<FString>/TArray<FName>/TArray<bool>"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Strings = UE.TArray("")
+            Strings:Add("A")
+            Strings:Add("中文")
+            local Names = UE.TArray(UE.FName)
+            Names:Add("Name")
+            local Bools = UE.TArray(true)
+            Bools:Add(false)
+            Bools:Add(true)
+            local T1, T2, T3 = Strings:ToTable(), Names:ToTable(), Bools:ToTable()
+            return T1[1] == "A" and T1[2] == "中文" and T2[1] == "Name" and T3[1] == false and T3[2] == true
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_TRUE(lua_toboolean(L, -1));
+        });
+
+        It(TEXT("TArray<FName>往返转换保留大小写和数字后缀"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Names = UE.TArray(UE.FName)
+            Names:FromTable({"UnLuaName", "unluaname", "UnLuaName_2", "", "中文"})
+            local T = Names:ToTable()
+            local T2 = Names:ToTable()
+            return T[1] == "UnLuaName" and T[2] == "unluaname" and T[3] == "UnLuaName_2" and T[4] == "None" and T[5] == "中文" and T2[3] == T[3]
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_TRUE(lua_toboolean(L, -1));
+        });
+
+        It(TEXT("转换TArray<FVector>，元素为拷贝"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(UE.FVector)
+            Array:Add(UE.FVector(1, 2, 3))
+            Array:Add(UE.FVector(4, 5, 6))
+            local Table = Array:ToTable()
+            Table[1].X = 100
+            return Table[2].Z, Array:Get(1).X, #Table
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tonumber(L, -3), 6.0);
+            TEST_EQUAL(lua_tonumber(L, -2), 1.0);
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+        });
+    });
+
+    Describe(TEXT("FromTable"), [this]
+    {
+        It(TEXT("使用LuaTable的内容替换数组"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(0)
+            Array:Add(100)
+            Array:FromTable({1, 2, 3})
+            return Array:Length(), Array:Get(1), Array:Get(3)
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -3), 3LL);
+            TEST_EQUAL(lua_tointeger(L, -2), 1LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 3LL);
+        });
+
+        It(TEXT("追加LuaTable中的结构体"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(UE.FVector)
+            Array:Add(UE.FVector(1, 1, 1))
+            Array:Append({UE.FVector(2, 2, 2), UE.FVector(3, 3, 3)})
+            return Array:Length(), Array:Get(2).Y, Array:Get(3).Z
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -3), 3LL);
+            TEST_EQUAL(lua_tonumber(L, -2), 2.0);
+            TEST_EQUAL(lua_tonumber(L, -1), 3.0);
+        });
+    });
+
+    Describe(TEXT("View"), [this]
+    {
+        It(TEXT("直接读写数值数组的内存"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(0)
+            Array:Add(1)
+            Array:Add(2)
+            Array:Add(3)
+            local View = Array:View()
+            View[1] = 10
+            View:Scale(2)
+            return #View, View:Sum(), Array:Get(1), View[4]
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -4), 3LL);
+            TEST_EQUAL(lua_tointeger(L, -3), 30LL);
+            TEST_EQUAL(lua_tointeger(L, -2), 20LL);
+            TEST_TRUE(lua_isnil(L, -1));
+        });
+
+        It(TEXT("数组扩容后视图仍然有效"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(0.0)
+            local View = Array:View()
+            for i = 1, 100 do
+                Array:Add(i)
+            end
+            View:Fill(0.5)
+            return View:Num(), View:Sum()
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -2), 100LL);
+            TEST_EQUAL(lua_tonumber(L, -1), 50.0);
+        });
+
+        It(TEXT("展开TArray<FVector>的分量，或按成员名获取视图"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(UE.FVector)
+            Array:Add(UE.FVector(1, 2, 3))
+            Array:Add(UE.FVector(4, 5, 6))
+            local Components = Array:View()
+            local Z = Array:View("Z")
+            Z:Fill(0)
+            return #Components, Components:Sum(), Array:Get(2).Z
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -3), 6LL);
+            TEST_EQUAL(lua_tonumber(L, -2), 12.0);
+            TEST_EQUAL(lua_tonumber(L, -1), 0.0);
+        });
+
+        It(TEXT("不同类型视图之间拷贝"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Ints = UE.TArray(0)
+            local Floats = UE.TArray(0.0)
+            for i = 1, 4 do
+                Ints:Add(i)
+                Floats:Add(0)
+            end
+            Floats:View():CopyFrom(Ints:View())
+            local Ok = pcall(function() Floats:View():CopyFrom(UE.TArray(0):View()) end)
+            return Floats:Get(4), Ok
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tonumber(L, -2), 4.0);
+            TEST_FALSE(lua_toboolean(L, -1));
+        });
+
+        It(TEXT("数组释放后访问视图报错"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+            Settings.DanglingCheck = true;
+            UnLua::Startup();
+
+            const auto ModuleEnv = IUnLuaModule::Get().GetEnv();
+            const auto Chunk1 = R"(
+            G_Struct = UE.FIssue517Struct()
+            G_Struct.ArrayFromStruct:Add(1)
+            G_View = G_Struct.ArrayFromStruct:View()
+            )";
+            TEST_TRUE(ModuleEnv->DoString(Chunk1));
+
+            const auto Chunk2 = R"(
+            local Ok1 = pcall(function() return G_View:Sum() end)
+            local Ok2 = pcall(function() G_View[1] = 2 end)
+            return Ok1, Ok2
+            )";
+            TEST_TRUE(ModuleEnv->DoString(Chunk2));
+            const auto ModuleL = ModuleEnv->GetMainState();
+            TEST_FALSE(lua_toboolean(ModuleL, -2));
+            TEST_FALSE(lua_toboolean(ModuleL, -1));
+
+            UnLua::Shutdown();
+            Settings.DanglingCheck = false;
+        });
     });
 
     Describe(TEXT("pairs"), [this]
@@ -725,6 +907,52 @@ void FUnLuaLibArraySpec::Define()
             TEST_EQUAL(Result2, 2);
         });
     });
+
+    Describe(TEXT("ForEach"), [this]
+    {
+        It(TEXT("遍历数组索引与元素"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(0)
+            Array:Add(100)
+            Array:Add(200)
+
+            local ret = {}
+            Array:ForEach(function(i, v)
+                table.insert(ret, i)
+                table.insert(ret, v)
+            end)
+            return ret;
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+
+            const auto Ret = UnLua::FLuaTable(Env.Get(), -1);
+            TEST_EQUAL(Ret.Length(), 4);
+            TEST_EQUAL(Ret[1].Value<int>(), 1)
+            TEST_EQUAL(Ret[2].Value<int>(), 100)
+            TEST_EQUAL(Ret[3].Value<int>(), 2)
+            TEST_EQUAL(Ret[4].Value<int>(), 200)
+        });
+
+        It(TEXT("返回false时中止遍历"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Array = UE.TArray(0)
+            Array:Add(1)
+            Array:Add(2)
+            Array:Add(3)
+
+            local Count = 0
+            Array:ForEach(function(i, v)
+                Count = Count + 1
+                return v < 2
+            end)
+            return Count
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+        });
+    });
 }
 
 #endif
@@ -184,6 +184,36 @@ void FUnLuaLibFVectorSpec::Define()
         });
     });
 
+    Describe(TEXT("MulAdd"), [this]
+    {
+        It(TEXT("原地累加向量乘以浮点数"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Vector = UE.FVector(1,2,3)\
+            Vector:MulAdd(UE.FVector(1,1,2), 2)\
+            return Vector\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            const auto& Vector = UnLua::Get<FVector>(L, -1, UnLua::TType<FVector>());
+            TEST_EQUAL(Vector, FVector(3,4,7));
+        });
+    });
+
+    Describe(TEXT("Lerp"), [this]
+    {
+        It(TEXT("原地写入两个向量的插值"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Vector = UE.FVector()\
+            Vector:Lerp(UE.FVector(0,0,0), UE.FVector(2,4,8), 0.5)\
+            return Vector\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            const auto& Vector = UnLua::Get<FVector>(L, -1, UnLua::TType<FVector>());
+            TEST_EQUAL(Vector, FVector(1,2,4));
+        });
+    });
+
     Describe(TEXT("unm"), [this]
     {
         It(TEXT("取反向量"), EAsyncExecution::TaskGraphMainThread, [this]()
@@ -385,6 +385,45 @@ void FUnLuaLibMapSpec::Define()
             TEST_EQUAL(Result1, 1);
             TEST_EQUAL(Result2, 2);
         });
+
+        It(TEXT("嵌套迭代同一个Map"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Map = UE.TMap(0, 0)
+            Map:Add(1, 100)
+            Map:Add(2, 200)
+
+            local Count = 0
+            for k1 in pairs(Map) do
+                for k2 in pairs(Map) do
+                    Count = Count + 1
+                end
+            end
+            return Count
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -1), 4LL);
+        });
+    });
+
+    Describe(TEXT("ForEach"), [this]
+    {
+        It(TEXT("遍历Key与Value"), EAsyncExecution::TaskGraphMainThread, [this]
+        {
+            const auto Chunk = R"(
+            local Map = UE.TMap(0, 0)
+            Map:Add(1, 100)
+            Map:Add(2, 200)
+
+            local Sum = 0
+            Map:ForEach(function(key, value)
+                Sum = Sum + key * value
+            end)
+            return Sum
+            )";
+            TEST_TRUE(Env->DoString(Chunk));
+            TEST_EQUAL(lua_tointeger(L, -1), 500LL);
+        });
     });
 }
 
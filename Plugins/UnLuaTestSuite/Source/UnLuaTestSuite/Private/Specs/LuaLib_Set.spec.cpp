@@ -252,6 +252,49 @@ void FUnLuaLibSetSpec::Define()
         });
     });
 
+    Describe(TEXT("pairs"), [this]()
+    {
+        It(TEXT("迭代获取所有元素"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Set = UE.TSet(0)\
+            Set:Add(1)\
+            Set:Add(2)\
+            Set:Add(3)\
+            Set:Remove(2)\
+            local Sum, Count = 0, 0\
+            for _, v in pairs(Set) do\
+                Sum = Sum + v\
+                Count = Count + 1\
+            end\
+            return Sum, Count\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            TEST_EQUAL(lua_tointeger(L, -2), 4LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 2LL);
+        });
+    });
+
+    Describe(TEXT("ForEach"), [this]()
+    {
+        It(TEXT("遍历所有元素，返回false时中止"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = "\
+            local Set = UE.TSet(0)\
+            Set:Add(1)\
+            Set:Add(2)\
+            local Sum = 0\
+            Set:ForEach(function(v) Sum = Sum + v end)\
+            local Count = 0\
+            Set:ForEach(function(v) Count = Count + 1 return false end)\
+            return Sum, Count\
+            ";
+            UnLua::RunChunk(L, Chunk);
+            TEST_EQUAL(lua_tointeger(L, -2), 3LL);
+            TEST_EQUAL(lua_tointeger(L, -1), 1LL);
+        });
+    });
+
     AfterEach([this]
     {
         UnLua::Shutdown();
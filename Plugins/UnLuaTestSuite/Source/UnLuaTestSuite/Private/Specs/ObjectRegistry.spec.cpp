@@ -0,0 +1,119 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "UnLuaDelegates.h"
+#include "UnLuaSettings.h"
+#include "LuaCore.h"
+#include "LuaEnv.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/LazyBindingTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FObjectRegistrySpec, "UnLua.API.ObjectRegistry", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    lua_State* L;
+    bool bLazyInstanceTables;
+    TArray<UObjectBaseUtility*> BindedObjects;
+    TArray<UObjectBaseUtility*> UnbindedObjects;
+    FDelegateHandle OnObjectBindedHandle;
+    FDelegateHandle OnObjectUnbindedHandle;
+
+    static void NotifyDeleted(UnLua::FLuaEnv& Env, UObject* Object)
+    {
+        // the same as what GUObjectArray does when the object is destroyed
+        Env.NotifyUObjectDeleted(Object, Object->GetUniqueID());
+    }
+END_DEFINE_SPEC(FObjectRegistrySpec)
+
+void FObjectRegistrySpec::Define()
+{
+    BeforeEach([this]
+    {
+        auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+        bLazyInstanceTables = Settings.bLazyInstanceTables;
+        Settings.bLazyInstanceTables = true;
+
+        BindedObjects.Empty();
+        UnbindedObjects.Empty();
+        OnObjectBindedHandle = FUnLuaDelegates::OnObjectBinded.AddLambda([this](UObjectBaseUtility* Object) { BindedObjects.Add(Object); });
+        OnObjectUnbindedHandle = FUnLuaDelegates::OnObjectUnbinded.AddLambda([this](UObjectBaseUtility* Object) { UnbindedObjects.Add(Object); });
+
+        UnLua::Startup();
+        L = UnLua::GetState();
+    });
+
+    Describe(TEXT("延迟绑定"), [this]()
+    {
+        It(TEXT("第一次压栈时才创建table并触发OnObjectBinded"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<ULazyBindingTestStub>();
+            TEST_EQUAL(BindedObjects.Num(), 0);
+
+            UnLua::PushUObject(L, Object);
+            TEST_TRUE(lua_istable(L, -1));
+            TEST_EQUAL(BindedObjects.Num(), 1);
+            TEST_TRUE(BindedObjects.Contains(Object));
+
+            UnLua::PushUObject(L, Object);
+            TEST_TRUE(lua_rawequal(L, -1, -2) == 1);
+            TEST_EQUAL(BindedObjects.Num(), 1);
+            lua_pop(L, 2);
+        });
+
+        It(TEXT("解绑还没有创建table的对象"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const auto Object = NewObject<ULazyBindingTestStub>();
+            NotifyDeleted(UnLua::FLuaEnv::FindEnvChecked(L), Object);
+            TEST_EQUAL(UnbindedObjects.Num(), 0);
+
+            // the binding is dropped, the table won't be created any more
+            TEST_FALSE(GetObjectMapping(L, Object));
+            TEST_EQUAL(BindedObjects.Num(), 0);
+        });
+
+        It(TEXT("创建table失败时清除延迟绑定"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            auto& Env = UnLua::FLuaEnv::FindEnvChecked(L);
+            const auto Object = NewObject<ULazyBindingTestStub>();
+
+            // the module of the class is released, so the table can't be created
+            NotifyDeleted(Env, Object->GetClass());
+            TEST_FALSE(GetObjectMapping(L, Object));
+            TEST_EQUAL(BindedObjects.Num(), 0);
+
+            // binds the class again, but the object stays unbound until it is bound explicitly
+            NewObject<ULazyBindingTestStub>();
+            TEST_FALSE(GetObjectMapping(L, Object));
+            TEST_FALSE(BindedObjects.Contains(Object));
+
+            TEST_TRUE(Env.TryBind(Object));
+            TEST_TRUE(GetObjectMapping(L, Object));
+            TEST_TRUE(lua_istable(L, -1));
+            TEST_TRUE(BindedObjects.Contains(Object));
+            lua_pop(L, 1);
+        });
+    });
+
+    AfterEach([this]
+    {
+        UnLua::Shutdown();
+
+        FUnLuaDelegates::OnObjectBinded.Remove(OnObjectBindedHandle);
+        FUnLuaDelegates::OnObjectUnbinded.Remove(OnObjectUnbindedHandle);
+        GetMutableDefault<UUnLuaSettings>()->bLazyInstanceTables = bLazyInstanceTables;
+    });
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
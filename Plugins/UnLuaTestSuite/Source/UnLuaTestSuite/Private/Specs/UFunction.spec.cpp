@@ -0,0 +1,68 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FUnLuaUFunctionSpec, "UnLua.API.UFunction", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    lua_State* L;
+    UUnLuaTestCallspaceStub* Stub;
+END_DEFINE_SPEC(FUnLuaUFunctionSpec)
+
+void FUnLuaUFunctionSpec::Define()
+{
+    BeforeEach([this]
+    {
+        UnLua::Startup();
+        L = UnLua::GetState();
+        Stub = NewObject<UUnLuaTestCallspaceStub>();
+        UnLua::PushUObject(L, Stub);
+        lua_setglobal(L, "G_Stub");
+    });
+
+    Describe(TEXT("Call"), [this]()
+    {
+        It(TEXT("正确调用原生函数"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            Stub->bDedicatedServer = true;
+            UnLua::RunChunk(L, "G_Stub:AddNativeCount() G_Stub:AddNativeCount()");
+            TEST_EQUAL(Stub->NativeCounter, 2);
+        });
+
+        It(TEXT("客户端上调用Cosmetic函数"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            Stub->bDedicatedServer = false;
+            UnLua::RunChunk(L, "G_Stub:AddCosmeticCount()");
+            TEST_EQUAL(Stub->CosmeticCounter, 1);
+        });
+
+        It(TEXT("专用服务器上不调用Cosmetic函数"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            Stub->bDedicatedServer = true;
+            UnLua::RunChunk(L, "G_Stub:AddCosmeticCount()");
+            TEST_EQUAL(Stub->CosmeticCounter, 0);
+        });
+    });
+
+    AfterEach([this]
+    {
+        UnLua::Shutdown();
+    });
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,63 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FUnLuaLibLegacyClassSpec, "UnLua.API.UnLua.Class", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    TSharedPtr<UnLua::FLuaEnv> Env;
+END_DEFINE_SPEC(FUnLuaLibLegacyClassSpec)
+
+void FUnLuaLibLegacyClassSpec::Define()
+{
+    BeforeEach([this]
+    {
+        Env = MakeShared<UnLua::FLuaEnv>();
+    });
+
+    Describe(TEXT("Index"), [this]()
+    {
+        It(TEXT("实例访问后重新定义的函数对新实例生效"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            const char* Chunk = R"(
+            local Base = UnLua.Class()
+            function Base:Foo() return 1 end
+            local M = UnLua.Class()
+            M.Super = Base
+
+            local A = setmetatable({}, M)
+            local Before = A:Foo()
+            Base.Foo = function() return 2 end
+            local B = setmetatable({}, M)
+            function M:Foo() return 3 end
+            local C = setmetatable({}, M)
+            return Before * 100 + B:Foo() * 10 + C:Foo()
+            )";
+            Env->DoString(Chunk);
+            const auto Actual = (int32)lua_tointeger(Env->GetMainState(), -1);
+            TEST_EQUAL(Actual, 123);
+        });
+    });
+
+    AfterEach([this]
+    {
+        Env.Reset();
+    });
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
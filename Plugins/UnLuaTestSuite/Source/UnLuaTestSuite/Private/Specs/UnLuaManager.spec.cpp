@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "UnLuaTemplate.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/InitializeTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FUnLuaManagerSpec, "UnLua.API.UnLuaManager", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    lua_State* L;
+
+    int32 GetInitializeCount() const
+    {
+        lua_getglobal(L, "G_InitializeCount");
+        const auto Count = (int32)lua_tointeger(L, -1);
+        lua_pop(L, 1);
+        return Count;
+    }
+END_DEFINE_SPEC(FUnLuaManagerSpec)
+
+void FUnLuaManagerSpec::Define()
+{
+    BeforeEach([this]
+    {
+        UnLua::Startup();
+        L = UnLua::GetState();
+    });
+
+    Describe(TEXT("Initialize"), [this]()
+    {
+        It(TEXT("同一模块的类再次绑定实例时调用Initialize"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            NewObject<UInitializeTestStub>();
+            TEST_EQUAL(GetInitializeCount(), 1);
+
+            NewObject<UInitializeTestStub>();
+            TEST_EQUAL(GetInitializeCount(), 2);
+        });
+
+        It(TEXT("模块热更新后新增的Initialize对之后绑定的实例生效"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            NewObject<ULateInitializeTestStub>();
+            TEST_EQUAL(GetInitializeCount(), 0);
+
+            // the same as hot reload, which patches the loaded module in place
+            const char* Chunk = R"(
+            local M = require("Tests.Specs.Initialize.LateInitializeTestStub")
+            function M:Initialize()
+                G_InitializeCount = (G_InitializeCount or 0) + 1
+            end
+            )";
+            UnLua::RunChunk(L, Chunk);
+
+            NewObject<ULateInitializeTestStub>();
+            TEST_EQUAL(GetInitializeCount(), 1);
+        });
+    });
+
+    AfterEach([this]
+    {
+        UnLua::Shutdown();
+    });
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,100 @@
+// Tencent is pleased to support the open source community by making UnLua available.
+// 
+// Copyright (C) 2019 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "UnLuaBase.h"
+#include "UnLuaSettings.h"
+#include "UnLuaTestHelpers.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FValueStructPropertySpec, "UnLua.API.ValueStructProperty", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+    lua_State* L;
+    bool bMathStructsAsTables;
+    UUnLuaTestValueStructStub* Stub;
+END_DEFINE_SPEC(FValueStructPropertySpec)
+
+void FValueStructPropertySpec::Define()
+{
+    BeforeEach([this]
+    {
+        // property descriptors are created by the settings at startup
+        auto& Settings = *GetMutableDefault<UUnLuaSettings>();
+        bMathStructsAsTables = Settings.bMathStructsAsTables;
+        Settings.bMathStructsAsTables = true;
+
+        UnLua::Startup();
+        L = UnLua::GetState();
+        Stub = NewObject<UUnLuaTestValueStructStub>();
+        UnLua::PushUObject(L, Stub);
+        lua_setglobal(L, "G_Stub");
+    });
+
+    Describe(TEXT("以table读写FVector/FRotator"), [this]()
+    {
+        It(TEXT("读取属性得到table"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            Stub->Location = FVector(1, 2, 3);
+            const char* Chunk = R"(
+            local V = G_Stub.Location
+            return type(V) == "table" and V.X == 1 and V.Y == 2 and V.Z == 3
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_TRUE(lua_toboolean(L, -1));
+        });
+
+        It(TEXT("写入具名table、数组table和userdata"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            UnLua::RunChunk(L, "G_Stub.Location = {X = 4, Y = 5, Z = 6}");
+            TEST_EQUAL(Stub->Location, FVector(4, 5, 6));
+
+            UnLua::RunChunk(L, "G_Stub.Rotation = {10, 20, 30}");
+            TEST_EQUAL(Stub->Rotation, FRotator(10, 20, 30));
+
+            UnLua::RunChunk(L, "G_Stub.Location = UE.FVector(7, 8, 9)");
+            TEST_EQUAL(Stub->Location, FVector(7, 8, 9));
+        });
+
+        It(TEXT("table字段类型不匹配时不写入参数"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            AddExpectedError(TEXT("Invalid parameter type calling ufunction"), EAutomationExpectedErrorFlags::Contains);
+            Stub->Location = FVector(1, 2, 3);
+            UnLua::RunChunk(L, "G_Stub:SetLocation({X = 1, Y = 'invalid', Z = 3})");
+            TEST_EQUAL(Stub->Location, FVector::ZeroVector);
+        });
+
+        It(TEXT("输出参数拷贝回传入的table"), EAsyncExecution::TaskGraphMainThread, [this]()
+        {
+            Stub->Location = FVector(1, 2, 3);
+            const char* Chunk = R"(
+            local Named = {}
+            local Packed = {0, 0, 0}
+            G_Stub:GetLocation(Named)
+            G_Stub:GetLocation(Packed)
+            return Named.X == 1 and Named.Y == 2 and Named.Z == 3
+                and Packed[1] == 1 and Packed[2] == 2 and Packed[3] == 3
+            )";
+            UnLua::RunChunk(L, Chunk);
+            TEST_TRUE(lua_toboolean(L, -1));
+        });
+    });
+
+    AfterEach([this]
+    {
+        UnLua::Shutdown();
+        GetMutableDefault<UUnLuaSettings>()->bMathStructsAsTables = bMathStructsAsTables;
+    });
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -82,4 +82,7 @@ public:
 
     UPROPERTY(BlueprintReadWrite)
     TArray<FVector> PredictedPositions;
+
+    UPROPERTY(BlueprintReadWrite)
+    UObject* Target;
 };
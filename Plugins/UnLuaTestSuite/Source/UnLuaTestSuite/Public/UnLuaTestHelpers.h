@@ -151,6 +151,55 @@ public:
     TSubclassOf<UUserWidget> TestForIssue445(int32 Index);
 };
 
+UCLASS()
+class UNLUATESTSUITE_API UUnLuaTestCallspaceStub : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    int32 NativeCounter;
+
+    UPROPERTY()
+    int32 CosmeticCounter;
+
+    UPROPERTY()
+    bool bDedicatedServer;
+
+    UFUNCTION(BlueprintCallable)
+    void AddNativeCount() { NativeCounter++; }
+
+    UFUNCTION(BlueprintCallable, BlueprintCosmetic)
+    void AddCosmeticCount() { CosmeticCounter++; }
+
+    virtual int32 GetFunctionCallspace(UFunction* Function, FFrame* Stack) override
+    {
+        // cosmetic functions are absorbed on dedicated servers
+        if (bDedicatedServer && Function->HasAnyFunctionFlags(FUNC_BlueprintCosmetic))
+            return FunctionCallspace::Absorbed;
+        return Super::GetFunctionCallspace(Function, Stack);
+    }
+};
+
+UCLASS()
+class UNLUATESTSUITE_API UUnLuaTestValueStructStub : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    FVector Location;
+
+    UPROPERTY()
+    FRotator Rotation;
+
+    UFUNCTION(BlueprintCallable)
+    void SetLocation(FVector InLocation) { Location = InLocation; }
+
+    UFUNCTION(BlueprintCallable)
+    void GetLocation(FVector& OutLocation) const { OutLocation = Location; }
+};
+
 USTRUCT(BlueprintType)
 struct UNLUATESTSUITE_API FUnLuaTestTableRow : public FTableRowBase
 {